@@ -0,0 +1,789 @@
+//
+//  main.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  micro benchmarks for ofxScrollViewCore.
+//  runs without openFrameworks or a GL context, time is driven by a fake clock
+//  that steps one 60 fps frame per update so results don't depend on the machine being idle.
+//
+//  usage:
+//  ofxScrollViewBenchmark [iterations]
+//
+//  prints nanoseconds per call, best of a few runs,
+//  and the number of heap allocations made inside the timed loop.
+//
+
+#include "ofxScrollViewCore.h"
+#include "ofxScrollViewCoreGroup.h"
+#include "ofxScrollViewList.h"
+#include "ofxScrollViewInputRecord.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------
+// every allocation in the process is counted,
+// the hot paths being measured are expected to make none.
+//--------------------------------------------------------------
+static std::atomic<int> numOfAllocs(0);
+
+void * operator new(std::size_t size) {
+    numOfAllocs++;
+    void * ptr = malloc(size > 0 ? size : 1);
+    if(ptr == NULL) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void * operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept {
+    free(ptr);
+}
+
+//--------------------------------------------------------------
+static float const kFrameTimeInSec = 1.0 / 60.0;
+static int const kNumOfRuns = 5;
+
+static double fakeTimeInSec = 0.0;
+static volatile float sink = 0.0; // stops the compiler throwing away results.
+
+static double getFakeTimeInSec() {
+    return fakeTimeInSec;
+}
+
+//--------------------------------------------------------------
+// scripted input, a touch gesture recorded as timestamped events.
+//--------------------------------------------------------------
+enum BenchmarkTouchType {
+    BENCHMARK_TOUCH_DOWN = 0,
+    BENCHMARK_TOUCH_MOVED,
+    BENCHMARK_TOUCH_UP
+};
+
+class BenchmarkTouchEvent {
+public:
+    BenchmarkTouchEvent(BenchmarkTouchType type, double timeSec, int x, int y, int id) {
+        this->type = type;
+        this->timeSec = timeSec;
+        this->x = x;
+        this->y = y;
+        this->id = id;
+    }
+    BenchmarkTouchType type;
+    double timeSec;
+    int x;
+    int y;
+    int id;
+};
+
+typedef std::vector<BenchmarkTouchEvent> BenchmarkScript;
+
+static BenchmarkScript makeDragScript(double timeStart, int numOfMoves) {
+    BenchmarkScript script;
+    double time = timeStart;
+    int x = 400;
+    int y = 300;
+    script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_DOWN, time, x, y, 0));
+    for(int i=0; i<numOfMoves; i++) {
+        time += kFrameTimeInSec;
+        x += (i % 2 == 0) ? 7 : -5;
+        y += (i % 3 == 0) ? 4 : -3;
+        script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_MOVED, time, x, y, 0));
+    }
+    time += kFrameTimeInSec;
+    script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_UP, time, x, y, 0));
+    return script;
+}
+
+static BenchmarkScript makePinchScript(double timeStart, int numOfMoves) {
+    BenchmarkScript script;
+    double time = timeStart;
+    int spread = 50;
+    script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_DOWN, time, 400 - spread, 300, 0));
+    script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_DOWN, time, 400 + spread, 300, 1));
+    for(int i=0; i<numOfMoves; i++) {
+        time += kFrameTimeInSec;
+        spread += (i % 2 == 0) ? 3 : -2;
+        script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_MOVED, time, 400 - spread, 300, 0));
+        script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_MOVED, time, 400 + spread, 300, 1));
+    }
+    time += kFrameTimeInSec;
+    script.push_back(BenchmarkTouchEvent(BENCHMARK_TOUCH_UP, time, 400 - spread, 300, 0));
+    return script;
+}
+
+static void playScript(ofxScrollViewCore & view, const BenchmarkScript & script) {
+    for(int i=0; i<script.size(); i++) {
+        const BenchmarkTouchEvent & event = script[i];
+        fakeTimeInSec = event.timeSec;
+        if(event.type == BENCHMARK_TOUCH_DOWN) {
+            view.touchDown(event.x, event.y, event.id);
+        } else if(event.type == BENCHMARK_TOUCH_MOVED) {
+            view.touchMoved(event.x, event.y, event.id);
+        } else if(event.type == BENCHMARK_TOUCH_UP) {
+            view.touchUp(event.x, event.y, event.id);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+static void setupView(ofxScrollViewCore & view) {
+    fakeTimeInSec = 0.0;
+    view.setClock(getFakeTimeInSec);
+    view.setWindowRect(ofxScrollViewRect(0, 0, 800, 600));
+    view.setContentRect(ofxScrollViewRect(0, 0, 8000, 6000));
+    view.setPinchZoom(true);
+    view.setPinchZoomSupported(true);
+    view.setScaleMin(0.1);
+    view.setScaleMax(4.0);
+    view.setup();
+    view.setScale(1.0);
+    view.setScrollPosition(0.5, 0.5, false);
+    view.update();
+}
+
+static void stepFrame(ofxScrollViewCore & view) {
+    fakeTimeInSec += kFrameTimeInSec;
+    view.update();
+}
+
+//--------------------------------------------------------------
+typedef std::chrono::steady_clock BenchmarkClock;
+
+static int numOfAllocsStart = 0;
+static int numOfAllocsTimed = 0; // allocations between startTimer() and getElapsedNanos().
+
+static BenchmarkClock::time_point startTimer() {
+    numOfAllocsStart = numOfAllocs;
+    return BenchmarkClock::now();
+}
+
+static double getElapsedNanos(BenchmarkClock::time_point timeStart) {
+    double nanos = std::chrono::duration<double, std::nano>(BenchmarkClock::now() - timeStart).count();
+    numOfAllocsTimed = numOfAllocs - numOfAllocsStart;
+    return nanos;
+}
+
+static void printResult(const std::string & name, double nanosPerCall, int numOfCalls, int numOfAllocsInRun) {
+    printf("%-40s %10.1f ns/call %12d calls %10d allocs\n", name.c_str(), nanosPerCall, numOfCalls, numOfAllocsInRun);
+}
+
+//--------------------------------------------------------------
+// update() in each state.
+// the state is primed before timing starts and topped up inside the loop
+// with the same single assignment a real frame would see from input.
+//--------------------------------------------------------------
+static double benchUpdateIdle(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+static double benchUpdateDragging(int iterations, bool bStats) {
+    ofxScrollViewCore view;
+    setupView(view);
+    view.getStats().setEnabled(bStats);
+    view.touchDown(400, 300, 0);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        view.dragMoved(ofxScrollViewVec2(400 + (i % 16), 300 - (i % 8)));
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+static double benchUpdateDragging(int iterations) {
+    return benchUpdateDragging(iterations, false);
+}
+
+static double benchUpdateDraggingStats(int iterations) {
+    return benchUpdateDragging(iterations, true);
+}
+
+static double benchUpdateDraggingLargeWorld(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    view.setLargeWorld(true);
+    view.touchDown(400, 300, 0);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        view.dragMoved(ofxScrollViewVec2(400 + (i % 16), 300 - (i % 8)));
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getRenderTransform().x;
+    return nanos / iterations;
+}
+
+// a 240 Hz digitizer, four samples between each update, drawn a frame ahead.
+static double benchUpdateDraggingPredicted(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    view.setInputPrediction(kFrameTimeInSec);
+    view.touchDown(400, 300, 0);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        for(int j=0; j<4; j++) {
+            fakeTimeInSec += kFrameTimeInSec * 0.25;
+            view.dragMoved(ofxScrollViewVec2(400 + ((i * 4 + j) % 64), 300 - ((i * 4 + j) % 32)));
+        }
+        view.update();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+static double benchUpdateFling(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    playScript(view, makeDragScript(1.0, 10));
+    ofxScrollViewVec2 flingVel(12, -9);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        if(view.dragVel.x == 0 || view.dragVel.y == 0) {
+            view.dragVel = (i % 2 == 0) ? flingVel : flingVel * -1.0; // keep it flinging back and forth.
+        }
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+static double benchUpdatePinchZooming(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    view.touchDown(350, 300, 0);
+    view.touchDown(450, 300, 1);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        view.zoomMoved(ofxScrollViewVec2(400, 300), 100 + (i % 64));
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+static double benchUpdateAnimating(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    view.zoomTo(ofxScrollViewVec2(400, 300), 1.0, iterations * kFrameTimeInSec * 2); // never finishes inside the loop.
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        stepFrame(view);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / iterations;
+}
+
+//--------------------------------------------------------------
+// transforms.
+//--------------------------------------------------------------
+static double benchContentPointAtScreenPoint(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    const ofxScrollViewRect & rect = view.getScrollRect();
+
+    float sum = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        ofxScrollViewVec2 screenPoint(i % 800, i % 600);
+        sum += view.getContentPointAtScreenPoint(rect, screenPoint).x;
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = sum;
+    return nanos / iterations;
+}
+
+static double benchScreenPointAtContentPoint(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    const ofxScrollViewRect & rect = view.getScrollRect();
+
+    float sum = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        ofxScrollViewVec2 contentPoint(i % 8000, i % 6000);
+        sum += view.getScreenPointAtContentPoint(rect, contentPoint).x;
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = sum;
+    return nanos / iterations;
+}
+
+//--------------------------------------------------------------
+// a million point track through the view each frame, batched against one call per point.
+//--------------------------------------------------------------
+static int const kNumOfBatchPoints = 1000000;
+
+static void setupBatchPoints(std::vector<float> & points) {
+    points.resize(kNumOfBatchPoints * 2);
+    for(int i=0; i<kNumOfBatchPoints; i++) {
+        points[i * 2 + 0] = (i * 7) % 8000;
+        points[i * 2 + 1] = (i * 13) % 6000;
+    }
+}
+
+static double benchBatchScreenPoints(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    std::vector<float> contentPoints;
+    std::vector<float> screenPoints(kNumOfBatchPoints * 2);
+    setupBatchPoints(contentPoints);
+
+    int numOfFrames = iterations / kNumOfBatchPoints + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfFrames; i++) {
+        view.getScreenPointsAtContentPoints(contentPoints.data(), screenPoints.data(), kNumOfBatchPoints);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = screenPoints[kNumOfBatchPoints];
+    return nanos / ((double)numOfFrames * kNumOfBatchPoints);
+}
+
+static double benchBatchScreenPointsSingle(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    const ofxScrollViewRect & rect = view.getScrollRect();
+    std::vector<float> contentPoints;
+    std::vector<float> screenPoints(kNumOfBatchPoints * 2);
+    setupBatchPoints(contentPoints);
+
+    int numOfFrames = iterations / kNumOfBatchPoints + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfFrames; i++) {
+        for(int j=0; j<kNumOfBatchPoints; j++) {
+            ofxScrollViewVec2 contentPoint(contentPoints[j * 2 + 0], contentPoints[j * 2 + 1]);
+            ofxScrollViewVec2 screenPoint = view.getScreenPointAtContentPoint(rect, contentPoint);
+            screenPoints[j * 2 + 0] = screenPoint.x;
+            screenPoints[j * 2 + 1] = screenPoint.y;
+        }
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = screenPoints[kNumOfBatchPoints];
+    return nanos / ((double)numOfFrames * kNumOfBatchPoints);
+}
+
+static double benchTransformForRect(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    ofxScrollViewRect rect = view.getScrollRect();
+
+    float sum = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        rect.x = -(float)(i % 1000);
+        sum += view.getTransformForRect(rect).x;
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = sum;
+    return nanos / iterations;
+}
+
+//--------------------------------------------------------------
+// touchDown / touchMoved / touchUp, timed per touch event.
+//--------------------------------------------------------------
+static double benchTouchScript(int iterations, const BenchmarkScript & script) {
+    ofxScrollViewCore view;
+    setupView(view);
+
+    int numOfGestures = iterations / script.size() + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfGestures; i++) {
+        playScript(view, script);
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.dragMovePos.x;
+    return nanos / (numOfGestures * script.size());
+}
+
+static double benchTouchDrag(int iterations) {
+    return benchTouchScript(iterations, makeDragScript(1.0, 30));
+}
+
+static double benchTouchPinch(int iterations) {
+    return benchTouchScript(iterations, makePinchScript(1.0, 30));
+}
+
+// the same drag posted to the input ring and drained by updateInputSources(), timed per touch event.
+static double benchTouchDragPosted(int iterations) {
+    ofxScrollViewCore view;
+    setupView(view);
+    BenchmarkScript script = makeDragScript(1.0, 30);
+    view.setInputSources(1, script.size());
+
+    int numOfGestures = iterations / script.size() + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfGestures; i++) {
+        for(int j=0; j<script.size(); j++) {
+            const BenchmarkTouchEvent & event = script[j];
+            if(event.type == BENCHMARK_TOUCH_DOWN) {
+                view.postTouchDown(event.x, event.y, event.id, 0, event.timeSec);
+            } else if(event.type == BENCHMARK_TOUCH_MOVED) {
+                view.postTouchMoved(event.x, event.y, event.id, 0, event.timeSec);
+            } else if(event.type == BENCHMARK_TOUCH_UP) {
+                view.postTouchUp(event.x, event.y, event.id, 0, event.timeSec);
+            }
+        }
+        view.updateInputSources();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.dragMovePos.x;
+    return nanos / (numOfGestures * script.size());
+}
+
+//--------------------------------------------------------------
+// a recorded session of drags and flings played back on a virtual clock, timed per update.
+//--------------------------------------------------------------
+static void recordSession(std::vector<ofxScrollViewInputEvent> & events) {
+    ofxScrollViewCore view;
+    setupView(view);
+
+    ofxScrollViewInputRecorder recorder;
+    recorder.start();
+    view.setInputRecorder(&recorder);
+
+    for(int i=0; i<10; i++) {
+        int direction = (i % 2 == 0) ? 1 : -1;
+        view.touchDown(400, 300, 0);
+        for(int j=1; j<=20; j++) {
+            view.touchMoved(400 - j * 15 * direction, 300 - j * 10 * direction, 0);
+            stepFrame(view);
+        }
+        view.touchUp(400 - 300 * direction, 300 - 200 * direction, 0);
+        for(int j=0; j<60; j++) {
+            stepFrame(view); // fling out.
+        }
+    }
+
+    recorder.stop();
+    events = recorder.getEvents();
+}
+
+static double benchReplaySession(int iterations) {
+    std::vector<ofxScrollViewInputEvent> events;
+    recordSession(events);
+
+    ofxScrollViewCore view;
+    setupView(view);
+    ofxScrollViewInputPlayer player;
+    player.setEvents(events);
+    player.setup(&view);
+
+    int numOfSessions = iterations / player.getNumOfUpdates() + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfSessions; i++) {
+        view.reset();
+        player.rewind();
+        while(player.update() == true) {
+            //
+        }
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = view.getTransform().x;
+    return nanos / (numOfSessions * player.getNumOfUpdates());
+}
+
+//--------------------------------------------------------------
+// many views, one update() each against one ofxScrollViewCoreGroup update().
+// timed per view, half of the views are flinging.
+//--------------------------------------------------------------
+static int const kNumOfGroupViews = 48;
+
+static void setupGroupViews(std::vector<ofxScrollViewCore> & views) {
+    for(int i=0; i<views.size(); i++) {
+        setupView(views[i]);
+        if(i % 2 == 0) {
+            views[i].dragVel.set(12, -9);
+        }
+    }
+}
+
+static void keepFlinging(std::vector<ofxScrollViewCore> & views, int frame) {
+    for(int i=0; i<views.size(); i+=2) {
+        if(views[i].dragVel.x == 0 || views[i].dragVel.y == 0) {
+            views[i].dragVel.set((frame % 2 == 0) ? 12 : -12, -9);
+        }
+    }
+}
+
+static double benchViewsUpdate(int iterations) {
+    std::vector<ofxScrollViewCore> views(kNumOfGroupViews);
+    setupGroupViews(views);
+
+    int numOfFrames = iterations / kNumOfGroupViews + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfFrames; i++) {
+        keepFlinging(views, i);
+        fakeTimeInSec += kFrameTimeInSec;
+        for(int j=0; j<views.size(); j++) {
+            views[j].update();
+        }
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = views[0].getTransform().x;
+    return nanos / (numOfFrames * kNumOfGroupViews);
+}
+
+static double benchGroupUpdate(int iterations) {
+    std::vector<ofxScrollViewCore> views(kNumOfGroupViews);
+    setupGroupViews(views);
+
+    ofxScrollViewCoreGroup group;
+    for(int i=0; i<views.size(); i++) {
+        group.add(&views[i]);
+    }
+
+    int numOfFrames = iterations / kNumOfGroupViews + 1;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfFrames; i++) {
+        keepFlinging(views, i);
+        fakeTimeInSec += kFrameTimeInSec;
+        group.update();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = views[0].getTransform().x;
+    return nanos / (numOfFrames * kNumOfGroupViews);
+}
+
+//--------------------------------------------------------------
+// content items, indexed against a plain loop over every item.
+// zoomed in so about one screen of content is visible,
+// the view is moved a little each query like a slow pan.
+//--------------------------------------------------------------
+static int const kNumOfContentItems = 10000;
+
+static void setupContentItems(ofxScrollViewCore & view, std::vector<ofxScrollViewRect> & itemRects) {
+    setupView(view);
+    view.zoomTo(ofxScrollViewVec2(400, 300), 0.23); // scale of about 1.
+    for(int i=0; i<600; i++) {
+        stepFrame(view);
+    }
+    srand(1);
+    itemRects.resize(kNumOfContentItems);
+    for(int i=0; i<itemRects.size(); i++) {
+        itemRects[i] = ofxScrollViewRect(rand() % 8000, rand() % 6000, 10 + rand() % 40, 10 + rand() % 40);
+        view.addContentItem(i, itemRects[i]);
+    }
+}
+
+static void panView(ofxScrollViewCore & view, int frame) {
+    view.setScrollPosition((frame % 100) * 0.01, 0.5, false);
+    stepFrame(view);
+}
+
+static double benchVisibleItemsIndexed(int iterations) {
+    ofxScrollViewCore view;
+    std::vector<ofxScrollViewRect> itemRects;
+    setupContentItems(view, itemRects);
+    std::vector<int> itemIDs;
+
+    int numOfQueries = iterations / 100 + 1;
+    int count = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfQueries; i++) {
+        panView(view, i);
+        view.getVisibleContentItems(itemIDs);
+        count += itemIDs.size();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = count;
+    return nanos / numOfQueries;
+}
+
+static double benchVisibleItemsLinear(int iterations) {
+    ofxScrollViewCore view;
+    std::vector<ofxScrollViewRect> itemRects;
+    setupContentItems(view, itemRects);
+    std::vector<int> itemIDs;
+
+    int numOfQueries = iterations / 100 + 1;
+    int count = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<numOfQueries; i++) {
+        panView(view, i);
+        itemIDs.clear();
+        ofxScrollViewRect visibleRect = view.getVisibleContentRect();
+        for(int j=0; j<itemRects.size(); j++) {
+            if(ofxScrollViewContentIndex::intersects(itemRects[j], visibleRect) == true) {
+                itemIDs.push_back(j);
+            }
+        }
+        count += itemIDs.size();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = count;
+    return nanos / numOfQueries;
+}
+
+static double benchItemAtScreenPoint(int iterations) {
+    ofxScrollViewCore view;
+    std::vector<ofxScrollViewRect> itemRects;
+    setupContentItems(view, itemRects);
+
+    int sum = 0;
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        sum += view.getContentItemAtScreenPoint(ofxScrollViewVec2(1 + i % 798, 1 + i % 598));
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = sum;
+    return nanos / iterations;
+}
+
+//--------------------------------------------------------------
+// virtualized list, the view pans through the list so cells are recycled every frame.
+// the time per update should not change with the number of rows.
+//--------------------------------------------------------------
+class BenchmarkListDataSource : public ofxScrollViewListDataSource {
+public:
+    int numOfRows;
+    bool bVariableRowHeights;
+    int getNumOfRows() { return numOfRows; }
+    int getNumOfColumns() { return 2; }
+    float getRowHeight(int row) { return bVariableRowHeights ? 20 + (row % 7) * 10 : 44; }
+    bool hasVariableRowHeights() { return bVariableRowHeights; }
+    float getEstimatedRowHeight() { return 50; }
+};
+
+static double benchListUpdate(int iterations, int numOfRows, bool bVariableRowHeights) {
+    fakeTimeInSec = 0.0;
+    ofxScrollViewCore view;
+    view.setClock(getFakeTimeInSec);
+    view.setWindowRect(ofxScrollViewRect(0, 0, 800, 600));
+
+    BenchmarkListDataSource dataSource;
+    dataSource.numOfRows = numOfRows;
+    dataSource.bVariableRowHeights = bVariableRowHeights;
+    ofxScrollViewList list;
+    list.setup(&view, &dataSource);
+    view.setScrollPosition(0, 0.5, false);
+
+    BenchmarkClock::time_point timeStart = startTimer();
+    for(int i=0; i<iterations; i++) {
+        if(i % 200 == 0) {
+            view.touchDown(400, 500, 0);
+        } else if(i % 200 < 100) {
+            view.touchMoved(400, 500 - (i % 200) * 8, 0);
+        } else if(i % 200 == 100) {
+            view.touchUp(400, 500 - 100 * 8, 0);
+        }
+        stepFrame(view);
+        list.update();
+    }
+    double nanos = getElapsedNanos(timeStart);
+    sink = list.getVisibleCells().size();
+    return nanos / iterations;
+}
+
+static double benchListUpdate100(int iterations) {
+    return benchListUpdate(iterations, 100, false);
+}
+
+static double benchListUpdate10M(int iterations) {
+    return benchListUpdate(iterations, 10000000, false);
+}
+
+static double benchListUpdateVariable10M(int iterations) {
+    return benchListUpdate(iterations, 10000000, true);
+}
+
+//--------------------------------------------------------------
+typedef double (*BenchmarkFunc)(int iterations);
+
+static void runBenchmark(const std::string & name, BenchmarkFunc func, int iterations) {
+    double best = func(iterations);
+    int allocsLeast = numOfAllocsTimed;
+    for(int i=1; i<kNumOfRuns; i++) {
+        double nanos = func(iterations);
+        if(nanos < best) {
+            best = nanos;
+        }
+        if(numOfAllocsTimed < allocsLeast) {
+            allocsLeast = numOfAllocsTimed;
+        }
+    }
+    printResult(name, best, iterations, allocsLeast);
+}
+
+//--------------------------------------------------------------
+int main(int argc, char * argv[]) {
+
+    int iterations = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if(iterations <= 0) {
+        printf("usage: ofxScrollViewBenchmark [iterations]\n");
+        return 1;
+    }
+
+    runBenchmark("update idle", benchUpdateIdle, iterations);
+    runBenchmark("update dragging", benchUpdateDragging, iterations);
+    runBenchmark("update dragging, stats on", benchUpdateDraggingStats, iterations);
+    runBenchmark("update dragging 240 Hz, predicted", benchUpdateDraggingPredicted, iterations);
+    runBenchmark("update dragging, large world", benchUpdateDraggingLargeWorld, iterations);
+    runBenchmark("update fling", benchUpdateFling, iterations);
+    runBenchmark("update pinch zooming", benchUpdatePinchZooming, iterations);
+    runBenchmark("update animating", benchUpdateAnimating, iterations);
+
+    runBenchmark("getContentPointAtScreenPoint", benchContentPointAtScreenPoint, iterations);
+    runBenchmark("getScreenPointAtContentPoint", benchScreenPointAtContentPoint, iterations);
+    runBenchmark("getTransformForRect", benchTransformForRect, iterations);
+    runBenchmark("1M points to screen, batched, per point", benchBatchScreenPoints, iterations);
+    runBenchmark("1M points to screen, one by one", benchBatchScreenPointsSingle, iterations);
+
+    runBenchmark("touch drag script", benchTouchDrag, iterations);
+    runBenchmark("touch pinch script", benchTouchPinch, iterations);
+    runBenchmark("touch drag script, posted", benchTouchDragPosted, iterations);
+    runBenchmark("replay recorded session, per update", benchReplaySession, iterations);
+
+    runBenchmark("48 views update, per view", benchViewsUpdate, iterations);
+    runBenchmark("48 views group update, per view", benchGroupUpdate, iterations);
+
+    runBenchmark("10k items visible query, indexed", benchVisibleItemsIndexed, iterations);
+    runBenchmark("10k items visible query, linear", benchVisibleItemsLinear, iterations);
+    runBenchmark("10k items getContentItemAtScreenPoint", benchItemAtScreenPoint, iterations);
+
+    runBenchmark("list update, 100 rows", benchListUpdate100, iterations);
+    runBenchmark("list update, 10M rows", benchListUpdate10M, iterations);
+    runBenchmark("list update, 10M variable rows", benchListUpdateVariable10M, iterations);
+
+    return 0;
+}
@@ -24,11 +24,21 @@ float Grid::getHeight() {
 }
 
 void Grid::draw() {
+    draw(ofRectangle(0, 0, width, height));
+}
+
+void Grid::draw(const ofRectangle & visibleRect) {
     int numOfRows = 20;
     int numOfCols = 20;
     float rowSize = height / numOfRows;
     float colSize = width / numOfCols;
     
+    // only the lines that intersect visibleRect are drawn.
+    int col0 = MAX((int)(visibleRect.x / colSize), 1);
+    int col1 = MIN((int)ceil((visibleRect.x + visibleRect.width) / colSize), numOfCols);
+    int row0 = MAX((int)(visibleRect.y / rowSize), 1);
+    int row1 = MIN((int)ceil((visibleRect.y + visibleRect.height) / rowSize), numOfRows);
+    
     ofSetColor(0);
     
     ofNoFill();
@@ -36,19 +46,19 @@ void Grid::draw() {
     ofSetLineWidth(2.0);
     ofRect(0, 0, width, height);
     
-    for(int yi=1; yi<numOfRows; yi++) {
-        int x0 = 0;
-        int x1 = width;
+    for(int yi=row0; yi<row1; yi++) {
+        int x0 = visibleRect.x;
+        int x1 = visibleRect.x + visibleRect.width;
         int y0 = yi * rowSize;
         int y1 = y0;
         ofLine(x0, y0, x1, y1);
     }
     
-    for(int xi=1; xi<numOfCols; xi++) {
+    for(int xi=col0; xi<col1; xi++) {
         int x0 = xi * colSize;
         int x1 = x0;
-        int y0 = 0;
-        int y1 = height;
+        int y0 = visibleRect.y;
+        int y1 = visibleRect.y + visibleRect.height;
         ofLine(x0, y0, x1, y1);
     }
     
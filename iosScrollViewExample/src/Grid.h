@@ -18,6 +18,7 @@ public:
     float getWidth();
     float getHeight();
     void draw();
+    void draw(const ofRectangle & visibleRect);
     
     float width;
     float height;
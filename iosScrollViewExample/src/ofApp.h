@@ -4,6 +4,7 @@
 #include "ofxiOS.h"
 #include "ofxiOSExtras.h"
 #include "ofxScrollView.h"
+#include "ofxScrollViewTileLayer.h"
 #include "Grid.h"
 
 class ofApp : public ofxiOSApp{
@@ -31,7 +32,8 @@ public:
     ofxScrollView scrollView;
     
     Grid grid;
-    ofTexture image;
+    ofxScrollViewTilePyramid tilePyramid;
+    ofxScrollViewTileLayer tileLayer;
     
     ofVec2f touchPoint;
     float touchTime = 0.0;
@@ -7,7 +7,9 @@ void ofApp::setup(){
     ofSetOrientation(OF_ORIENTATION_90_LEFT);
     
     //----------------------------------------------------------
-    ofLoadImage(image, "sample_image.jpg");
+    tilePyramid.setup("sample_image.jpg", 256); // cuts the image into 256px tiles at every mip level.
+    tileLayer.setup(&tilePyramid);
+    tileLayer.cache.setTextureBudgetInBytes(32 * 1024 * 1024); // hard limit on tile texture memory.
     
     //----------------------------------------------------------
     windowRect.width = ofGetWidth();
@@ -39,6 +41,8 @@ void ofApp::setup(){
 void ofApp::update(){
 
     scrollView.update();
+    
+    tileLayer.update(scrollView); // picks the pyramid level and loads the visible tiles.
 }
 
 //--------------------------------------------------------------
@@ -46,17 +50,16 @@ void ofApp::draw(){
 	
     // ofxScrollView returns a matrix to do any transformations manually,
     // otherwise drawing things between begin() and end() methods will also do the trick.
+    // drawContent() wraps begin() and end() and passes in the visible part of the content,
+    // so only what is on screen needs to be drawn.
     
     ofMatrix4x4 mat;
     mat = scrollView.getMatrix();
     
-    scrollView.begin();
-    
-    image.draw(0, 0, grid.getWidth(), grid.getHeight());
-    
-    grid.draw();
-    
-    scrollView.end();
+    scrollView.drawContent([&](const ofRectangle & visibleRect) {
+        tileLayer.draw();
+        grid.draw(visibleRect);
+    });
     
     scrollView.draw();
     
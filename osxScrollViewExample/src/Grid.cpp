@@ -29,46 +29,30 @@ float Grid::getHeight() {
 }
 
 void Grid::draw() {
+    draw(ofRectangle(0, 0, size.x, size.y));
+}
+
+void Grid::draw(const ofRectangle & visibleRect) {
     ofSetColor(255);
-    ofRect(0, 0, size.x, size.y);
+    ofRect(visibleRect); // the lines are in the geometry layer and the cell numbers in the label layer.
+}
 
+void Grid::addLines(ofxScrollViewGeometryLayer & geometryLayer) {
+    ofRectangle rect(0, 0, size.x, size.y);
+    geometryLayer.addRect(rect, ofColor::red);
+    geometryLayer.addGrid(rect, 20, 20, ofColor::red);
+}
+
+void Grid::addLabels(ofxScrollViewLabelLayer & labelLayer) {
     int countX = 20;
     int countY = 20;
     float sizeX = size.x / countX;
     float sizeY = size.y / countY;
     
-    ofSetColor(0);
-    
     for(int yi=0; yi<countY; yi++) {
         for(int xi=0; xi<countX; xi++) {
             int i = (yi * countX) + xi;
-            int x = xi * sizeX;
-            int y = yi * sizeY;
-            
-            ofDrawBitmapString(ofToString(i), x + 10, y + 20);
+            labelLayer.addLabel(i, ofToString(i), ofVec2f(xi * sizeX + 10, yi * sizeY + 10), 1);
         }
     }
-    
-    ofNoFill();
-    ofSetColor(ofColor::red);
-    ofRect(0, 0, size.x, size.y);
-    
-    for(int yi=1; yi<countY; yi++) {
-        int x0 = 0;
-        int x1 = size.x;
-        int y0 = yi * sizeY;
-        int y1 = y0;
-        ofLine(x0, y0, x1, y1);
-    }
-    
-    for(int xi=1; xi<countX; xi++) {
-        int x0 = xi * sizeX;
-        int x1 = x0;
-        int y0 = 0;
-        int y1 = size.y;
-        ofLine(x0, y0, x1, y1);
-    }
-    
-    ofFill();
-    ofSetColor(255);
 }
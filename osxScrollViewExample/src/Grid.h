@@ -7,6 +7,8 @@
 #pragma once
 
 #include "ofMain.h"
+#include "ofxScrollViewLabelLayer.h"
+#include "ofxScrollViewGeometryLayer.h"
 
 class Grid {
     
@@ -19,6 +21,9 @@ public:
     float getWidth();
     float getHeight();
     void draw();
+    void draw(const ofRectangle & visibleRect);
+    void addLines(ofxScrollViewGeometryLayer & geometryLayer);    // outline and cell lines, built once.
+    void addLabels(ofxScrollViewLabelLayer & labelLayer);   // cell numbers, from lod level 1 up where they can be read.
     
     ofVec2f size;
 };
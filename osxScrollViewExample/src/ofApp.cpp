@@ -35,14 +35,26 @@ void ofApp::setup(){
     scrollView.setDoubleTapZoomIncrementTimeInSec(0.3); // the time amount of time for zoom increment.
     scrollView.setDoubleTapRegistrationTimeInSec(0.25); // the time threshold between taps for double tap event to register.
     scrollView.setDoubleTapRegistrationDistanceInPixels(20); // the distance threshold between taps for double tap event to register.
+    scrollView.setLodHysteresis(0.02); // how far past a level of detail threshold the zoom goes before the level changes.
     
     scrollView.setup(); // setup must always be called at the end of scroll view config.
+    
+    //----------------------------------------------------------
+    labelLayer.setup(contentRect); // text labels cached in a texture atlas and drawn in one batch.
+    grid.addLabels(labelLayer);
+    
+    geometryLayer.setup([&](ofxScrollViewGeometryLayer & layer, const ofRectangle & rect) {
+        grid.addLines(layer); // called again whenever the content rect changes.
+    });
+    geometryLayer.setLineWidth(1.0, true); // stays one screen pixel wide at any zoom.
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
     
     scrollView.update();
+    labelLayer.update(scrollView);
+    geometryLayer.update(scrollView);
 }
 
 //--------------------------------------------------------------
@@ -50,15 +62,17 @@ void ofApp::draw(){
     
     // ofxScrollView returns a matrix to do any transformations manually,
     // otherwise drawing things between begin() and end() methods will also do the trick.
+    // drawContent() wraps begin() and end() and passes in the visible part of the content,
+    // so only what is on screen needs to be drawn.
     
     ofMatrix4x4 mat;
     mat = scrollView.getMatrix();
     
-    scrollView.begin();
-    
-    grid.draw();
-    
-    scrollView.end();
+    scrollView.drawContent([&](const ofRectangle & visibleRect) {
+        grid.draw(visibleRect);
+        geometryLayer.draw();
+        labelLayer.draw();
+    });
     
     ofSetColor(0);
     ofBeginShape();
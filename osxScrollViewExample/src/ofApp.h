@@ -2,6 +2,7 @@
 
 #include "ofMain.h"
 #include "ofxScrollView.h"
+#include "ofxScrollViewLabelLayer.h"
 #include "Grid.h"
 
 class ofApp : public ofBaseApp{
@@ -28,6 +29,8 @@ public:
     ofxScrollView scrollView;
     
     Grid grid;
+    ofxScrollViewLabelLayer labelLayer;
+    ofxScrollViewGeometryLayer geometryLayer;
     
     ofVec2f touchPoint;
     float touchTime = 0.0;
@@ -7,48 +7,29 @@
 #include "ofxScrollView.h"
 
 //--------------------------------------------------------------
-static float const kEasingStop = 0.001;
+static double getElapsedTimeInSec() {
+    return ofGetElapsedTimeMicros() / 1000000.0; // ofGetElapsedTimef() is a float, too coarse after a few hours.
+}
 
 //--------------------------------------------------------------
 ofxScrollView::ofxScrollView() {
     
     bUserInteractionEnabled = false;
-    bPinchZoomEnabled = false;
-    bPinchZoomSupported = false;
-    
-    scrollEasing = 0.5;
-    bounceBack = 1.0;
-    
-    dragVelDecay = 0.9;
-    bDragging = false;
-    
-    zoomDownDist = 0;
-    zoomMoveDist = 0;
-    bZooming = false;
-    
-    animTimeStart = 0.0;
-    animTimeTotal = 0.0;
-    bAnimating = false;
     
-    bDoubleTapZoomEnabled = false;
-    doubleTapZoomRangeMin = 0.0;
-    doubleTapZoomRangeMax = 1.0;
-    doubleTapZoomIncrement = 1.0;
-    doubleTapZoomIncrementTimeInSec = 0.2;
-    doubleTapRegistrationTimeInSec = 0.25;
-    doubleTapRegistrationDistanceInPixels = 22;
-    
-    scale = 1.0;
-    scaleDown = 1.0;
-    scaleMin = 1.0;
-    scaleMax = 1.0;
+    bContentCacheEnabled = false;
+    bContentCacheValid = false;
+    contentCacheMargin = 256;
+    contentCacheScaleThreshold = 0.25;
+    contentCacheScale = 1.0;
+    contentCacheTileSize = 512;
+    contentCacheTileCols = 0;
+    contentCacheTileRows = 0;
     
+    setClock(getElapsedTimeInSec);
     setUserInteraction(true);
-    setPinchZoom(true);
-    setDoubleTapZoom(true);
     
 #ifdef TARGET_OPENGLES
-    bPinchZoomSupported = true;
+    setPinchZoomSupported(true);
 #endif
 }
 
@@ -89,851 +70,448 @@ void ofxScrollView::setUserInteraction(bool bEnable) {
     }
 }
 
-void ofxScrollView::setPinchZoom(bool value) {
-    bPinchZoomEnabled = value;
-}
-
-void ofxScrollView::setScrollEasing(float value) {
-    scrollEasing = value;
-}
-
-void ofxScrollView::setBounceBack(float value) {
-    bounceBack = value;
-}
-
-void ofxScrollView::setDragVelocityDecay(float value) {
-    dragVelDecay = value;
-}
-
-void ofxScrollView::setDoubleTapZoom(bool value) {
-    bDoubleTapZoomEnabled = value;
-}
-
-void ofxScrollView::setDoubleTapZoomRangeMin(float value) {
-    doubleTapZoomRangeMin = value;
-}
-
-void ofxScrollView::setDoubleTapZoomRangeMax(float value) {
-    doubleTapZoomRangeMax = value;
-}
-
-void ofxScrollView::setDoubleTapZoomIncrement(float value) {
-    doubleTapZoomIncrement = value;
-}
-
-void ofxScrollView::setDoubleTapZoomIncrementTimeInSec(float value) {
-    doubleTapZoomIncrementTimeInSec = value;
-}
-
-void ofxScrollView::setDoubleTapRegistrationTimeInSec(float value) {
-    doubleTapRegistrationTimeInSec = value;
-}
-
-void ofxScrollView::setDoubleTapRegistrationDistanceInPixels(float value) {
-    doubleTapRegistrationDistanceInPixels = value;
-}
-
 //--------------------------------------------------------------
 void ofxScrollView::setup() {
     if(windowRect.isEmpty() == true) {
         setWindowRect(ofRectangle(0, 0, ofGetWidth(), ofGetHeight()));
     }
     
-    if(contentRect.isEmpty() == true) {
-        setContentRect(windowRect);
-    }
-    
-    reset();
+    ofxScrollViewCore::setup();
 }
 
 void ofxScrollView::reset() {
-    touchPoints.clear();
-    
-    dragDownPos.set(0);
-    dragMovePos.set(0);
-    dragMovePosPrev.set(0);
-    dragVel.set(0);
-    bDragging = false;
-    
-    zoomDownPos.set(0);
-    zoomMovePos.set(0);
-    zoomMovePosPrev.set(0);
-    bZooming = false;
-    
-    animTimeStart = 0.0;
-    animTimeTotal = 0.0;
-    bAnimating = false;
-    
-    scale = scaleMin;
-    scaleDown = scaleMin;
-    
-    scrollRect.width = scrollRectEased.width = contentRect.width * scale;
-    scrollRect.height = scrollRectEased.height = contentRect.height * scale;
-    scrollRect = scrollRectEased = getRectContainedInWindowRect(scrollRect);
+    ofxScrollViewCore::reset();
     
-    mat = getMatrixForRect(scrollRect);
+    mat = getMatrixForTransform(renderTransform);
 }
 
 //--------------------------------------------------------------
 void ofxScrollView::setWindowRect(const ofRectangle & rect) {
-    if(windowRect == rect) {
-        return;
-    }
-    windowRect = rect;
+    ofxScrollViewCore::setWindowRect(toCore(rect));
 }
 
 void ofxScrollView::setContentRect(const ofRectangle & rect) {
-    if(contentRect == rect) {
-        return;
-    }
-    contentRect = rect;
+    ofxScrollViewCore::setContentRect(toCore(rect));
 }
 
 //--------------------------------------------------------------
 void ofxScrollView::fitContentToWindow(ofAspectRatioMode aspectRatioMode) {
-    float sx = windowRect.width / contentRect.width;
-    float sy = windowRect.height / contentRect.height;
-    
     if(aspectRatioMode == OF_ASPECT_RATIO_KEEP) {
-        scaleMin = MIN(sx, sy);
+        ofxScrollViewCore::fitContentToWindow(OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP);
     } else if(aspectRatioMode == OF_ASPECT_RATIO_KEEP_BY_EXPANDING) {
-        scaleMin = MAX(sx, sy);
+        ofxScrollViewCore::fitContentToWindow(OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP_BY_EXPANDING);
     } else {
-        scaleMin = 1.0;
-    }
-    
-    scaleMin = MIN(scaleMin, 1.0);
-    scaleMax = 1.0;
-    scale = scaleMin;
-}
-
-//--------------------------------------------------------------
-void ofxScrollView::setScale(float value) {
-    scale = value;
-    scale = ofClamp(scale, scaleMin, scaleMax);
-}
-
-void ofxScrollView::setScaleMin(float value) {
-    scaleMin = value;
-    scale = ofClamp(scale, scaleMin, scaleMax);
-}
-
-void ofxScrollView::setScaleMax(float value) {
-    scaleMax = value;
-    scale = ofClamp(scale, scaleMin, scaleMax);
-}
-
-//--------------------------------------------------------------
-float ofxScrollView::getScale() {
-    return scale;
-}
-
-float ofxScrollView::getScaleMin() {
-    return scaleMin;
-}
-
-float ofxScrollView::getScaleMax() {
-    return scaleMax;
-}
-
-//--------------------------------------------------------------
-void ofxScrollView::setZoom(float value) {
-    float zoom = ofClamp(value, 0.0, 1.0);
-    scale = zoomToScale(zoom);
-}
-
-float ofxScrollView::getZoom() {
-    float zoom = scaleToZoom(scale);
-    return zoom;
-}
-
-bool ofxScrollView::isZoomed() {
-    float zoom = getZoom();
-    return (zoom > 0.0);
-}
-
-bool ofxScrollView::isZoomedInMax() {
-    float zoom = getZoom();
-    return (zoom == 1.0);
-}
-
-bool ofxScrollView::isZoomedOutMax() {
-    float zoom = getZoom();
-    return (zoom == 0.0);
-}
-
-//--------------------------------------------------------------
-float ofxScrollView::zoomToScale(float value) {
-    if(scaleMin == scaleMax) {
-        return scaleMin;
+        ofxScrollViewCore::fitContentToWindow(OFX_SCROLL_VIEW_ASPECT_RATIO_IGNORE);
     }
-    return ofMap(value, 0.0, 1.0, scaleMin, scaleMax, true);
-}
-
-float ofxScrollView::scaleToZoom(float value) {
-    if(scaleMin == scaleMax) {
-        return 0.0;
-    }
-    return ofMap(value, scaleMin, scaleMax, 0.0, 1.0, true);
 }
 
 //--------------------------------------------------------------
 void ofxScrollView::zoomToMin(const ofVec2f & screenPoint, float timeSec) {
-    zoomTo(screenPoint, scaleMin, timeSec);
+    ofxScrollViewCore::zoomToMin(toCore(screenPoint), timeSec);
 }
 
 void ofxScrollView::zoomToMax(const ofVec2f & screenPoint, float timeSec) {
-    zoomTo(screenPoint, scaleMax, timeSec);
+    ofxScrollViewCore::zoomToMax(toCore(screenPoint), timeSec);
 }
 
 void ofxScrollView::zoomTo(const ofVec2f & screenPoint, float zoom, float timeSec) {
-    bool bAnimate = animStart(timeSec);
-    
-    scrollRectAnim0 = scrollRect;
-    scrollRectAnim1 = scrollRect;
-    scrollRectAnim1 = getRectZoomedAtScreenPoint(scrollRectAnim1, screenPoint, zoom);
-    scrollRectAnim1 = getRectContainedInWindowRect(scrollRectAnim1);
-    
-    if(bAnimate == false) {
-        scrollRect = scrollRectEased = scrollRectAnim1;
-    }
+    ofxScrollViewCore::zoomTo(toCore(screenPoint), zoom, timeSec);
 }
 
 void ofxScrollView::zoomToContentPointAndPositionAtScreenPoint(const ofVec2f & contentPoint,
                                                                const ofVec2f & screenPoint,
                                                                float zoom,
                                                                float timeSec) {
-    bool bAnimate = animStart(timeSec);
-
-    scrollRectAnim0 = scrollRect;
-    scrollRectAnim1 = scrollRect;
-    scrollRectAnim1 = getRectWithContentPointAtScreenPoint(scrollRectAnim1, contentPoint, screenPoint);
-    scrollRectAnim1 = getRectZoomedAtScreenPoint(scrollRectAnim1, screenPoint, zoom);
-    scrollRectAnim1 = getRectContainedInWindowRect(scrollRectAnim1);
-    
-    if(bAnimate == false) {
-        scrollRect = scrollRectEased = scrollRectAnim1;
-    }
+    ofxScrollViewCore::zoomToContentPointAndPositionAtScreenPoint(toCore(contentPoint),
+                                                                  toCore(screenPoint),
+                                                                  zoom,
+                                                                  timeSec);
 }
 
 void ofxScrollView::moveContentPointToScreenPoint(const ofVec2f & contentPoint,
                                                   const ofVec2f & screenPoint,
                                                   float timeSec) {
-    bool bAnimate = animStart(timeSec);
-
-    scrollRectAnim0 = scrollRect;
-    scrollRectAnim1 = scrollRect;
-    scrollRectAnim1 = getRectWithContentPointAtScreenPoint(scrollRectAnim1, contentPoint, screenPoint);
-    
-    if(bAnimate == false) {
-        scrollRect = scrollRectEased = scrollRectAnim1;
-    }
-}
-
-
-bool ofxScrollView::animStart(float animTimeInSec) {
-    bAnimating = true;
-
-    animTimeStart = ofGetElapsedTimef();
-    animTimeTotal = MAX(animTimeInSec, 0.0);
-    
-    if(animTimeTotal < 0.001) {
-        animTimeTotal = 0;
-        bAnimating = false;
-    }
-    
-    return bAnimating;
+    ofxScrollViewCore::moveContentPointToScreenPoint(toCore(contentPoint),
+                                                     toCore(screenPoint),
+                                                     timeSec);
 }
 
 //--------------------------------------------------------------
-void ofxScrollView::setScrollPositionX(float x, bool bEase) {
-    dragCancel();
-    zoomCancel();
-    
-    float px = ofClamp(x, 0.0, 1.0);
-    scrollRect.x = windowRect.x - (scrollRect.width - windowRect.width) * px;
-    if(bEase == false) {
-        scrollRectEased.x = scrollRect.x;
-    }
-}
-
-void ofxScrollView::setScrollPositionY(float y, bool bEase) {
-    dragCancel();
-    zoomCancel();
-    
-    float py = ofClamp(y, 0.0, 1.0);
-    scrollRect.y = windowRect.y - (scrollRect.height - windowRect.height) * py;
-    if(bEase == false) {
-        scrollRectEased.y = scrollRect.y;
-    }
-}
-
-void ofxScrollView::setScrollPosition(float x, float y, bool bEase) {
-    setScrollPositionX(x, bEase);
-    setScrollPositionY(y, bEase);
-}
-
 ofVec2f ofxScrollView::getScrollPosition() {
-    return ofVec2f(scrollRectEased.x, scrollRectEased.y);
+    return toOf(ofxScrollViewCore::getScrollPosition());
 }
 
 ofVec2f ofxScrollView::getScrollPositionNorm() {
-    ofVec2f scrollPosEasedNorm;
-    
-    float dx = windowRect.width - scrollRect.width;
-    float dy = windowRect.height - scrollRect.height;
-    if(dx >= 0) {
-        scrollPosEasedNorm.x = 0;
-    } else {
-        scrollPosEasedNorm.x = ofMap(scrollRectEased.x, dx, 0.0, 1.0, 0.0, true);
-    }
-    if(dy >= 0) {
-        scrollPosEasedNorm.y = 0;
-    } else {
-        scrollPosEasedNorm.y = ofMap(scrollRectEased.y, dy, 0.0, 1.0, 0.0, true);
-    }
-    
-    return scrollPosEasedNorm;
+    return toOf(ofxScrollViewCore::getScrollPositionNorm());
 }
 
 //--------------------------------------------------------------
 const ofRectangle & ofxScrollView::getWindowRect() {
-    return windowRect;
+    windowRectOf = toOf(windowRect);
+    return windowRectOf;
 }
 
 const ofRectangle & ofxScrollView::getContentRect() {
-    return contentRect;
+    contentRectOf = toOf(contentRect);
+    return contentRectOf;
 }
 
 const ofRectangle & ofxScrollView::getScrollRect() {
-    return scrollRect;
+    scrollRectOf = toOf(scrollRect);
+    return scrollRectOf;
 }
 
 const ofMatrix4x4 & ofxScrollView::getMatrix() {
     return mat;
 }
 
+ofRectangle ofxScrollView::getVisibleContentRect() {
+    return toOf(ofxScrollViewCore::getVisibleContentRect());
+}
+
+ofRectangle ofxScrollView::getPredictedScrollRect(int numOfFrames) {
+    return toOf(ofxScrollViewCore::getPredictedScrollRect(numOfFrames));
+}
+
+ofRectangle ofxScrollView::getPredictedVisibleContentRect(int numOfFrames) {
+    return toOf(ofxScrollViewCore::getPredictedVisibleContentRect(numOfFrames));
+}
+
 //--------------------------------------------------------------
-void ofxScrollView::update() {
+void ofxScrollView::updateEnd() {
+    ofxScrollViewCore::updateEnd();
     
-    if(bAnimating == true) {
-        
-        float timeNow = ofGetElapsedTimef();
-        float progress = ofMap(timeNow, animTimeStart, animTimeStart + animTimeTotal, 0.0, 1.0, true);
-        bAnimating = (progress < 1.0);
-        
-        ofRectangle rect = getRectLerp(scrollRectAnim0, scrollRectAnim1, progress);
-        scrollRect = rect;
-        
-        scale = scrollRect.width / contentRect.width;
-        
-    } else {
-        
-        //==========================================================
-        // dragging.
-        //==========================================================
-        
-        if(bDragging == true || bZooming == true) {
-            
-            if(bDragging == true) {
-                
-                dragVel = dragMovePos - dragMovePosPrev;
-                dragMovePosPrev = dragMovePos;
-                
-            } else if(bZooming == true) {
-                
-                dragVel = zoomMovePos - zoomMovePosPrev;
-                zoomMovePosPrev = zoomMovePos;
-            }
-            
-            scrollRect.x += dragVel.x;
-            scrollRect.y += dragVel.y;
-            
-        } else {
-            
-            dragVel *= dragVelDecay;
-            if(ABS(dragVel.x) < kEasingStop) {
-                dragVel.x = 0;
-            }
-            if(ABS(dragVel.y) < kEasingStop) {
-                dragVel.y = 0;
-            }
-            bool bAddVel = true;
-            bAddVel = bAddVel && (ABS(dragVel.x) > 0);
-            bAddVel = bAddVel && (ABS(dragVel.y) > 0);
-            if(bAddVel == true) {
-                scrollRect.x += dragVel.x;
-                scrollRect.y += dragVel.y;
-            }
-        }
-        
-        //==========================================================
-        // zooming.
-        //==========================================================
-        
-        if(bZooming == true) {
-            
-            float zoomUnitDist = ofVec2f(windowRect.width, windowRect.height).length(); // diagonal.
-            float zoomRange = scaleMax - scaleMin;
-            float zoomDiff = 0;
-            
-            if(bPinchZoomSupported == true) {
-                
-                zoomDiff = zoomMoveDist - zoomDownDist;
-                zoomDiff *= 4;
-                
-            } else {
-                
-                zoomDiff = zoomMovePos.x - zoomDownPos.x;
-            }
-            
-            float zoom = ofMap(zoomDiff, -zoomUnitDist, zoomUnitDist, -zoomRange, zoomRange, true);
-            
-            scale = scaleDown + zoom;
-            scale = MAX(scale, 0.0);
-            
-            if(scale < scaleMin) {
-                scale = scaleMin;
-            } else if(scale > scaleMax) {
-                scale = scaleMax;
-            }
-            
-            float zoomScale = scaleToZoom(scale);
-            ofRectangle rect = getRectZoomedAtScreenPoint(scrollRect, zoomMovePos, zoomScale);
-            scrollRect = rect;
-        }
+    if(needsRedraw() == true) {
+        stats.beginPhase(OFX_SCROLL_VIEW_PHASE_MATRIX);
+        mat = getMatrixForTransform(renderTransform); // relative to the render origin, the same as transform unless it's a large world.
+        stats.endPhase(OFX_SCROLL_VIEW_PHASE_MATRIX);
     }
     
-    scrollRect = getRectContainedInWindowRect(scrollRect, bounceBack);
-    
-    //==========================================================
-    // apply easing to scrollRect.
-    //==========================================================
-    
-    scrollRectEased.x += (scrollRect.x - scrollRectEased.x) * scrollEasing;
-    scrollRectEased.y += (scrollRect.y - scrollRectEased.y) * scrollEasing;
-    scrollRectEased.width += (scrollRect.width - scrollRectEased.width) * scrollEasing;
-    scrollRectEased.height += (scrollRect.height - scrollRectEased.height) * scrollEasing;
-    
-    if(ABS(scrollRect.x - scrollRectEased.x) < kEasingStop) {
-        scrollRectEased.x = scrollRect.x;
-    }
-    if(ABS(scrollRect.y - scrollRectEased.y) < kEasingStop) {
-        scrollRectEased.y = scrollRect.y;
-    }
-    if(ABS(scrollRect.width - scrollRectEased.width) < kEasingStop) {
-        scrollRectEased.width = scrollRect.width;
-    }
-    if(ABS(scrollRect.height - scrollRectEased.height) < kEasingStop) {
-        scrollRectEased.height = scrollRect.height;
+    if(hasRenderOriginChanged() == true) {
+        bContentCacheValid = false; // the tiles were drawn relative to the old origin.
     }
-    
-    mat = getMatrixForRect(scrollRectEased);
 }
 
 //-------------------------------------------------------------- the brains!
-ofRectangle ofxScrollView::getRectContainedInWindowRect(const ofRectangle & rectToContain,
+ofRectangle ofxScrollView::getRectContainedInWindowRect(const ofRectangle & rect,
                                                         float easing) {
-
-    ofRectangle rect = rectToContain;
-    ofRectangle boundingRect = windowRect;
-    ofRectangle contentRectMin = contentRect;
-    contentRectMin.width *= scaleMin;
-    contentRectMin.height *= scaleMin;
-    
-    if(rect.width < windowRect.width) {
-        boundingRect.x = windowRect.x + (windowRect.width - contentRectMin.width) * 0.5;
-        boundingRect.width = contentRectMin.width;
-    }
-    if(rect.height < windowRect.height) {
-        boundingRect.y = windowRect.y + (windowRect.height - contentRectMin.height) * 0.5;
-        boundingRect.height = contentRectMin.height;
-    }
-    
-    float x0 = boundingRect.x - MAX(rect.width - boundingRect.width, 0.0);
-    float x1 = boundingRect.x;
-    float y0 = boundingRect.y - MAX(rect.height - boundingRect.height, 0.0);
-    float y1 = boundingRect.y;
-    
-    if(rect.x < x0) {
-        rect.x += (x0 - rect.x) * easing;
-        if(ABS(x0 - rect.x) < kEasingStop) {
-            rect.x = x0;
-        }
-    } else if(rect.x > x1) {
-        rect.x += (x1 - rect.x) * easing;
-        if(ABS(x1 - rect.x) < kEasingStop) {
-            rect.x = x1;
-        }
-    }
-    
-    if(rect.y < y0) {
-        rect.y += (y0 - rect.y) * easing;
-        if(ABS(y0 - rect.y) < kEasingStop) {
-            rect.y = y0;
-        }
-    } else if(rect.y > y1) {
-        rect.y += (y1 - rect.y) * easing;
-        if(ABS(y1 - rect.y) < kEasingStop) {
-            rect.y = y1;
-        }
-    }
-    
-    return rect;
+    return toOf(ofxScrollViewCore::getRectContainedInWindowRect(toCore(rect), easing));
 }
 
 ofRectangle ofxScrollView::getRectZoomedAtScreenPoint(const ofRectangle & rect,
                                                       const ofVec2f & screenPoint,
                                                       float zoom) {
-    
-    float zoomScale = zoomToScale(zoom);
-    
-    ofVec2f contentPoint = getContentPointAtScreenPoint(rect, screenPoint);
-    
-    ofVec2f p0(0, 0);
-    ofVec2f p1(contentRect.width, contentRect.height);
-    p0 -= contentPoint;
-    p1 -= contentPoint;
-    p0 *= zoomScale;
-    p1 *= zoomScale;
-    p0 += screenPoint;
-    p1 += screenPoint;
-    
-    ofRectangle rectNew;
-    rectNew.x = p0.x;
-    rectNew.y = p0.y;
-    rectNew.width = p1.x - p0.x;
-    rectNew.height = p1.y - p0.y;
-    
-    return rectNew;
+    return toOf(ofxScrollViewCore::getRectZoomedAtScreenPoint(toCore(rect), toCore(screenPoint), zoom));
 }
 
 ofRectangle ofxScrollView::getRectWithContentPointAtScreenPoint(const ofRectangle & rect,
                                                                 const ofVec2f & contentPoint,
                                                                 const ofVec2f & screenPoint) {
-    
-    ofVec2f contentScreenPoint = getScreenPointAtContentPoint(rect, contentPoint);
-    ofVec2f contentPointToScreenPointDifference = screenPoint - contentScreenPoint;
-    
-    ofRectangle rectNew;
-    rectNew = scrollRect;
-    rectNew.x += contentPointToScreenPointDifference.x;
-    rectNew.y += contentPointToScreenPointDifference.y;
-    
-    return rectNew;
+    return toOf(ofxScrollViewCore::getRectWithContentPointAtScreenPoint(toCore(rect), toCore(contentPoint), toCore(screenPoint)));
 }
 
 ofRectangle ofxScrollView::getRectLerp(const ofRectangle & rectFrom,
                                        const ofRectangle & rectTo,
                                        float progress) {
-    
-    ofVec3f r00 = rectFrom.getTopLeft();
-    ofVec3f r01 = rectFrom.getBottomRight();
-    
-    ofVec3f r10 = rectTo.getTopLeft();
-    ofVec3f r11 = rectTo.getBottomRight();
-    
-    ofVec3f r20 = r00.interpolate(r10, progress);
-    ofVec3f r21 = r01.interpolate(r11, progress);
-    
-    ofRectangle rect;
-    rect.set(r20, r21);
-    
-    return rect;
+    return toOf(ofxScrollViewCore::getRectLerp(toCore(rectFrom), toCore(rectTo), progress));
 }
 
 ofMatrix4x4 ofxScrollView::getMatrixForRect(const ofRectangle & rect) {
+    return getMatrixForTransform(getTransformForRect(toCore(rect)));
+}
+
+ofMatrix4x4 ofxScrollView::getMatrixForTransform(const ofxScrollViewTransform & rectTransform) {
     
-    float rectScale = rect.width / contentRect.width;
-    
+    // scale then translate, written straight into the matrix instead of multiplying two of them.
+    float s = rectTransform.scale;
     ofMatrix4x4 rectMat;
-    rectMat.preMultTranslate(ofVec3f(rect.x, rect.y, 0.0));
-    rectMat.preMultScale(ofVec3f(rectScale, rectScale, 1.0));
+    rectMat.set(s,               0,               0, 0,
+                0,               s,               0, 0,
+                0,               0,               1, 0,
+                rectTransform.x, rectTransform.y, 0, 1);
     
     return rectMat;
 }
 
+ofRectangle ofxScrollView::getVisibleContentRectForRect(const ofRectangle & rect,
+                                                        float margin) {
+    return toOf(ofxScrollViewCore::getVisibleContentRectForRect(toCore(rect), margin));
+}
+
 ofVec2f ofxScrollView::getContentPointAtScreenPoint(const ofRectangle & rect,
                                                     const ofVec2f & screenPoint) {
-    
-    ofVec2f contentPoint;
-    contentPoint.x = ofMap(screenPoint.x, rect.x, rect.x + rect.width, 0, contentRect.width, true);
-    contentPoint.y = ofMap(screenPoint.y, rect.y, rect.y + rect.height, 0, contentRect.height, true);
-    return contentPoint;
+    return toOf(ofxScrollViewCore::getContentPointAtScreenPoint(toCore(rect), toCore(screenPoint)));
 }
 
 ofVec2f ofxScrollView::getScreenPointAtContentPoint(const ofRectangle & rect,
                                                     const ofVec2f & contentPoint) {
-    
-    ofVec2f screenPoint;
-    screenPoint.x = ofMap(contentPoint.x, 0, contentRect.width, rect.x, rect.x + rect.width, true);
-    screenPoint.y = ofMap(contentPoint.y, 0, contentRect.height, rect.y, rect.y + rect.height, true);
-    return screenPoint;
+    return toOf(ofxScrollViewCore::getScreenPointAtContentPoint(toCore(rect), toCore(contentPoint)));
 }
 
+//--------------------------------------------------------------
+void ofxScrollView::getScreenPointsAtContentPoints(const std::vector<ofVec2f> & contentPoints, std::vector<ofVec2f> & screenPoints) {
+    screenPoints.resize(contentPoints.size());
+    if(contentPoints.empty() == true) {
+        return;
+    }
+    ofxScrollViewCore::getScreenPointsAtContentPoints(contentPoints[0].getPtr(), screenPoints[0].getPtr(), contentPoints.size());
+}
+
+void ofxScrollView::getContentPointsAtScreenPoints(const std::vector<ofVec2f> & screenPoints, std::vector<ofVec2f> & contentPoints) {
+    contentPoints.resize(screenPoints.size());
+    if(screenPoints.empty() == true) {
+        return;
+    }
+    ofxScrollViewCore::getContentPointsAtScreenPoints(screenPoints[0].getPtr(), contentPoints[0].getPtr(), screenPoints.size());
+}
 
 //--------------------------------------------------------------
-void ofxScrollView::begin() {
-    ofPushMatrix();
-    ofMultMatrix(mat);
+void ofxScrollView::addContentItem(int itemID, const ofRectangle & rect) {
+    ofxScrollViewCore::addContentItem(itemID, toCore(rect));
 }
 
-void ofxScrollView::end() {
-    ofPopMatrix();
+void ofxScrollView::moveContentItem(int itemID, const ofRectangle & rect) {
+    ofxScrollViewCore::moveContentItem(itemID, toCore(rect));
 }
 
-void ofxScrollView::draw() {
-    //
+int ofxScrollView::getContentItemAtScreenPoint(const ofVec2f & screenPoint) {
+    return ofxScrollViewCore::getContentItemAtScreenPoint(toCore(screenPoint));
 }
 
 //--------------------------------------------------------------
-void ofxScrollView::exit() {
-    //
+void ofxScrollView::invalidateContentRect(const ofRectangle & rect) {
+    ofxScrollViewCore::invalidateContentRect(toCore(rect));
 }
 
 //--------------------------------------------------------------
-void ofxScrollView::dragDown(const ofVec2f & point) {
-    dragDownPos = dragMovePos = dragMovePosPrev = point;
-    dragVel.set(0);
-    
-    bDragging = true;
-    bAnimating = false;
+ofRectangle ofxScrollView::toOf(const ofxScrollViewRect & rect) {
+    return ofRectangle(rect.x, rect.y, rect.width, rect.height);
 }
 
-void ofxScrollView::dragMoved(const ofVec2f & point) {
-    dragMovePos = point;
+ofVec2f ofxScrollView::toOf(const ofxScrollViewVec2 & point) {
+    return ofVec2f(point.x, point.y);
 }
 
-void ofxScrollView::dragUp(const ofVec2f & point) {
-    dragMovePos = point;
-    
-    bDragging = false;
+ofxScrollViewRect ofxScrollView::toCore(const ofRectangle & rect) {
+    return ofxScrollViewRect(rect.x, rect.y, rect.width, rect.height);
 }
 
-void ofxScrollView::dragCancel() {
-    dragVel.set(0);
-    
-    bDragging = false;
+ofxScrollViewVec2 ofxScrollView::toCore(const ofVec2f & point) {
+    return ofxScrollViewVec2(point.x, point.y);
 }
 
 //--------------------------------------------------------------
-void ofxScrollView::zoomDown(const ofVec2f & point, float pointDist) {
-    if(bPinchZoomEnabled == false) {
+void ofxScrollView::begin() {
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_DRAW);
+    ofPushMatrix();
+    ofMultMatrix(mat);
+}
+
+void ofxScrollView::end() {
+    ofPopMatrix();
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_DRAW);
+}
+
+void ofxScrollView::draw() {
+    //
+}
+
+void ofxScrollView::drawContent(const ofxScrollViewDrawCallback & drawCallback) {
+    ofRectangle visibleRect = toOf(getRectRelativeToRenderOrigin(ofxScrollViewCore::getVisibleContentRect()));
+    if(visibleRect.isEmpty() == true) {
         return;
     }
     
-    zoomDownPos = zoomMovePos = zoomMovePosPrev = point;
-    zoomDownDist = zoomMoveDist = pointDist;
-    
-    scaleDown = scale;
-    
-    bZooming = true;
-    bAnimating = false;
-}
-
-void ofxScrollView::zoomMoved(const ofVec2f & point, float pointDist) {
-    if(bPinchZoomEnabled == false) {
+    if(bContentCacheEnabled == true) {
+        if(needsContentCacheRender() == true) {
+            renderContentCache(drawCallback);
+        } else if(hasDirtyContentRects() == true) {
+            renderContentCacheDirty(drawCallback);
+        }
+        drawContentCache();
         return;
     }
     
-    zoomMovePos = point;
-    zoomMoveDist = pointDist;
+    begin();
+    drawCallback(visibleRect);
+    end();
+    
+    clearDirtyContentRects(); // everything was drawn.
 }
 
-void ofxScrollView::zoomUp(const ofVec2f & point, float pointDist) {
-    if(bPinchZoomEnabled == false) {
+//-------------------------------------------------------------- content cache.
+void ofxScrollView::setContentCache(bool bEnable) {
+    if(bContentCacheEnabled == bEnable) {
         return;
     }
+    bContentCacheEnabled = bEnable;
+    bContentCacheValid = false;
     
-    zoomMovePos = point;
-    zoomMoveDist = pointDist;
-    
-    bZooming = false;
+    if(bContentCacheEnabled == false) {
+        contentCacheTiles.clear(); // free the textures.
+        contentCacheTileCols = 0;
+        contentCacheTileRows = 0;
+    }
 }
 
-void ofxScrollView::zoomCancel() {
-    bZooming = false;
+void ofxScrollView::setContentCacheMargin(float value) {
+    contentCacheMargin = MAX(value, 0);
+    bContentCacheValid = false;
 }
 
-//--------------------------------------------------------------
-void ofxScrollView::mouseMoved(int x, int y) {
-    //
+void ofxScrollView::setContentCacheScaleThreshold(float value) {
+    contentCacheScaleThreshold = value;
 }
 
-void ofxScrollView::mousePressed(int x, int y, int button) {
-    if(button == 0) {
-        
-        touchDown(x, y, 0);
-        
-    } else if(button == 2) {
-        
-        touchDown(x, y, 0);
-        touchDown(x, y, 2);
-    }
+void ofxScrollView::setContentCacheTileSize(int value) {
+    contentCacheTileSize = MAX(value, 16);
+    contentCacheTiles.clear();
+    contentCacheTileCols = 0;
+    contentCacheTileRows = 0;
+    bContentCacheValid = false;
 }
 
-void ofxScrollView::mouseDragged(int x, int y, int button) {
-    touchMoved(x, y, button);
+void ofxScrollView::clearContentCache() {
+    bContentCacheValid = false;
 }
 
-void ofxScrollView::mouseReleased(int x, int y, int button) {
-    touchUp(x, y, button);
+bool ofxScrollView::isContentCacheEnabled() {
+    return bContentCacheEnabled;
 }
 
-//--------------------------------------------------------------
-void ofxScrollView::touchDown(int x, int y, int id) {
-    bool bHit = windowRect.inside(x, y);
-    if(bHit == false) {
-        return;
+bool ofxScrollView::needsContentCacheRender() {
+    if(bContentCacheValid == false) {
+        return true;
     }
-
-    ofxScrollViewTouchPoint touchPointNew;
-    touchPointNew.touchPos.set(x, y);
-    touchPointNew.touchID = id;
-    touchPointNew.touchDownTimeInSec = ofGetElapsedTimef();
-    
-    //---------------------------------------------------------- double tap.
-    ofVec2f touchPointDiff = touchPointNew.touchPos - touchDownPointLast.touchPos;
-    float touchTimeDiff = touchPointNew.touchDownTimeInSec - touchDownPointLast.touchDownTimeInSec;
-    
-    touchDownPointLast = touchPointNew;
     
-    bool bDoubleTap = true;
-    bDoubleTap = bDoubleTap && (touchTimeDiff < doubleTapRegistrationTimeInSec);
-    bDoubleTap = bDoubleTap && (touchPointDiff.length() < doubleTapRegistrationDistanceInPixels);
-    
-    if(bDoubleTapZoomEnabled == true &&
-       bDoubleTap == true) {
-        
-        dragCancel();
-        zoomCancel();
-
-        touchPoints.clear();
-        touchDownPointLast.touchPos.set(0, 0);
-        touchDownPointLast.touchDownTimeInSec = 0.0;
-        
-        touchDoubleTap(x, y, id);
-        return;
+    ofRectangle windowContentRect = toOf(getRectRelativeToRenderOrigin(getVisibleContentRectForRect(scrollRectInterpolated)));
+    if(contentCacheRect.inside(windowContentRect) == false) {
+        return true; // moved past the cached margin.
     }
     
-    //----------------------------------------------------------
-    if(touchPoints.size() >= 2) {
-        // max 2 touches.
-        return;
-    }
-    
-    touchPoints.push_back(touchPointNew);
-    
-    if(touchPoints.size() == 1) {
-        
-        zoomCancel();
-        dragDown(touchPoints[0].touchPos);
-        
-    } else if(touchPoints.size() == 2) {
-        
-        ofVec2f tp0(touchPoints[0].touchPos);
-        ofVec2f tp1(touchPoints[1].touchPos);
-        ofVec2f tmp = (tp1 - tp0) * 0.5 + tp0;
-        float dist = (tp1 - tp0).length();
-        
-        dragCancel();
-        zoomDown(tmp, dist);
+    float scaleChange = fabs(transform.scale / contentCacheScale - 1.0);
+    if(isSettled() == true) {
+        return scaleChange > 0.001;
     }
+    return scaleChange > contentCacheScaleThreshold;
 }
 
-void ofxScrollView::touchMoved(int x, int y, int id) {
-    int touchIndex = -1;
-    for(int i=0; i<touchPoints.size(); i++) {
-        ofxScrollViewTouchPoint & touchPoint = touchPoints[i];
-        if(touchPoint.touchID == id) {
-            touchPoint.touchPos.x = x;
-            touchPoint.touchPos.y = y;
-            touchIndex = i;
-            break;
-        }
-    }
+void ofxScrollView::renderContentCache(const ofxScrollViewDrawCallback & drawCallback) {
     
-    if(touchIndex == -1) {
-        return;
-    }
+    // the tiles cover the window plus the margin, at the current scale.
+    int cacheWidth = windowRect.width + contentCacheMargin * 2;
+    int cacheHeight = windowRect.height + contentCacheMargin * 2;
+    int tileCols = ceil(cacheWidth / (float)contentCacheTileSize);
+    int tileRows = ceil(cacheHeight / (float)contentCacheTileSize);
     
-    if(touchPoints.size() == 1) {
-        
-        dragMoved(touchPoints[0].touchPos);
-        
-    } else if(touchPoints.size() == 2) {
-        
-        ofVec2f tp0(touchPoints[0].touchPos);
-        ofVec2f tp1(touchPoints[1].touchPos);
-        ofVec2f tmp = (tp1 - tp0) * 0.5 + tp0;
-        float dist = (tp1 - tp0).length();
-        
-        zoomMoved(tmp, dist);
-    }
-}
-
-void ofxScrollView::touchUp(int x, int y, int id) {
-    int touchIndex = -1;
-    for(int i=0; i<touchPoints.size(); i++) {
-        ofxScrollViewTouchPoint & touchPoint = touchPoints[i];
-        if(touchPoint.touchID == id) {
-            touchPoint.touchPos.x = x;
-            touchPoint.touchPos.y = y;
-            touchIndex = i;
-            break;
+    if(tileCols != contentCacheTileCols || tileRows != contentCacheTileRows) {
+        contentCacheTileCols = tileCols;
+        contentCacheTileRows = tileRows;
+        contentCacheTiles.clear();
+        contentCacheTiles.resize(tileCols * tileRows);
+        for(int i=0; i<contentCacheTiles.size(); i++) {
+            contentCacheTiles[i].allocate(contentCacheTileSize, contentCacheTileSize, GL_RGBA);
         }
     }
     
-    if(touchIndex == -1) {
-        return;
-    }
+    // kept relative to the render origin, like everything else drawn under mat.
+    contentCacheScale = renderTransform.scale;
+    contentCacheRect.x = (windowRect.x - contentCacheMargin - renderTransform.x) / contentCacheScale;
+    contentCacheRect.y = (windowRect.y - contentCacheMargin - renderTransform.y) / contentCacheScale;
+    contentCacheRect.width = tileCols * contentCacheTileSize / contentCacheScale;
+    contentCacheRect.height = tileRows * contentCacheTileSize / contentCacheScale;
     
-    if(touchPoints.size() == 1) {
-        
-        dragUp(touchPoints[0].touchPos);
-        
-    } else if(touchPoints.size() == 2) {
-     
-        ofVec2f tp0(touchPoints[0].touchPos);
-        ofVec2f tp1(touchPoints[1].touchPos);
-        ofVec2f tmp = (tp1 - tp0) * 0.5 + tp0;
-        float dist = (tp1 - tp0).length();
-        
-        zoomUp(tmp, dist);
+    for(int i=0; i<contentCacheTiles.size(); i++) {
+        renderContentCacheTile(i, drawCallback);
     }
     
-    touchPoints.clear();
+    clearDirtyContentRects();
+    bContentCacheValid = true;
 }
 
-void ofxScrollView::touchDoubleTap(int x, int y, int id) {
-    if(bDoubleTapZoomEnabled == false) {
-        return;
-    }
+void ofxScrollView::renderContentCacheDirty(const ofxScrollViewDrawCallback & drawCallback) {
     
-    bool bHit = windowRect.inside(x, y);
-    if(bHit == false) {
-        return;
+    // only the tiles touching a dirty rect are drawn again.
+    const std::vector<ofxScrollViewRect> & dirtyRects = getDirtyContentRects();
+    for(int i=0; i<contentCacheTiles.size(); i++) {
+        ofRectangle tileRect = getContentCacheTileRect(i);
+        for(int j=0; j<dirtyRects.size(); j++) {
+            if(tileRect.intersects(toOf(getRectRelativeToRenderOrigin(dirtyRects[j]))) == true) {
+                renderContentCacheTile(i, drawCallback);
+                break;
+            }
+        }
     }
     
-    ofVec2f touchPoint(x, y);
+    clearDirtyContentRects();
+}
+
+void ofxScrollView::renderContentCacheTile(int tileIndex, const ofxScrollViewDrawCallback & drawCallback) {
     
-    float zoomCurrent = getZoom();
-    float zoomTarget = 0.0;
+    ofRectangle tileRect = getContentCacheTileRect(tileIndex);
+    ofRectangle contentDrawRect = toOf(getRectRelativeToRenderOrigin(ofxScrollViewRect(0, 0, contentRect.width, contentRect.height)));
+    ofRectangle drawRect = tileRect.getIntersection(contentDrawRect);
     
-    bool bZoomedInMax = (zoomCurrent == doubleTapZoomRangeMax);
-    if(bZoomedInMax == true) {
-        zoomTarget = doubleTapZoomRangeMin; // zoom all the way out.
-    } else {
-        zoomTarget = zoomCurrent + doubleTapZoomIncrement;
+    ofFbo & tile = contentCacheTiles[tileIndex];
+    tile.begin();
+    ofClear(0, 0, 0, 0);
+    ofPushMatrix();
+    ofScale(contentCacheScale, contentCacheScale);
+    ofTranslate(-tileRect.x, -tileRect.y);
+    if(drawRect.isEmpty() == false) {
+        drawCallback(drawRect); // the tile clips anything drawn outside of it.
     }
-    zoomTarget = ofClamp(zoomTarget, doubleTapZoomRangeMin, doubleTapZoomRangeMax);
-    
-    float zoomTimeSec = ABS(zoomTarget - zoomCurrent);
-    zoomTimeSec *= doubleTapZoomIncrementTimeInSec;
+    ofPopMatrix();
+    tile.end();
+}
+
+ofRectangle ofxScrollView::getContentCacheTileRect(int tileIndex) {
+    float tileSize = contentCacheTileSize / contentCacheScale;
     
-    zoomTo(touchPoint, zoomTarget, zoomTimeSec);
+    ofRectangle tileRect;
+    tileRect.x = contentCacheRect.x + (tileIndex % contentCacheTileCols) * tileSize;
+    tileRect.y = contentCacheRect.y + (tileIndex / contentCacheTileCols) * tileSize;
+    tileRect.width = tileSize;
+    tileRect.height = tileSize;
+    return tileRect;
 }
 
-void ofxScrollView::touchCancelled(int x, int y, int id) {
+void ofxScrollView::drawContentCache() {
+    ofPushStyle();
+    ofSetColor(255);
+    begin();
+    for(int i=0; i<contentCacheTiles.size(); i++) {
+        ofRectangle tileRect = getContentCacheTileRect(i);
+        contentCacheTiles[i].draw(tileRect.x, tileRect.y, tileRect.width, tileRect.height);
+    }
+    end();
+    ofPopStyle();
+}
+
+//--------------------------------------------------------------
+void ofxScrollView::exit() {
     //
 }
+
+//--------------------------------------------------------------
+void ofxScrollView::scrollSettled() {
+    ofxScrollViewEventArgs args;
+    args.scrollView = this;
+    ofNotifyEvent(settledEvent, args, this);
+}
+
+void ofxScrollView::scrollMoving() {
+    ofxScrollViewEventArgs args;
+    args.scrollView = this;
+    ofNotifyEvent(movingEvent, args, this);
+}
+
+void ofxScrollView::lodChanged(int lodLevelPrev) {
+    bContentCacheValid = false; // the content draws differently at the new level.
+    
+    ofxScrollViewLodEventArgs args;
+    args.scrollView = this;
+    args.lodLevel = getLodLevel();
+    args.lodLevelPrev = lodLevelPrev;
+    ofNotifyEvent(lodChangedEvent, args, this);
+}
@@ -7,21 +7,38 @@
 #pragma once
 
 #include "ofMain.h"
+#include "ofxScrollViewCore.h"
 
 //--------------------------------------------------------------
-class ofxScrollViewTouchPoint {
+class ofxScrollView;
+
+class ofxScrollViewEventArgs : public ofEventArgs {
 public:
-    ofxScrollViewTouchPoint() {
-        touchID = 0;
-        touchDownTimeInSec = 0;
+    ofxScrollViewEventArgs() {
+        scrollView = NULL;
     }
-    int touchID;
-    ofVec2f touchPos;
-    float touchDownTimeInSec;
+    ofxScrollView * scrollView;
 };
 
+class ofxScrollViewLodEventArgs : public ofxScrollViewEventArgs {
+public:
+    ofxScrollViewLodEventArgs() {
+        lodLevel = 0;
+        lodLevelPrev = 0;
+    }
+    int lodLevel;
+    int lodLevelPrev;
+};
+
+//--------------------------------------------------------------
+typedef std::function<void(const ofRectangle & visibleContentRect)> ofxScrollViewDrawCallback;
+
 //--------------------------------------------------------------
-class ofxScrollView {
+// openFrameworks front end for ofxScrollViewCore.
+// registers for mouse or touch events, runs on ofGetElapsedTimef(),
+// takes and returns openFrameworks types and builds the matrix to draw content with.
+//--------------------------------------------------------------
+class ofxScrollView : public ofxScrollViewCore {
     
 public:
     
@@ -29,43 +46,23 @@ public:
     ~ofxScrollView();
     
     void setUserInteraction(bool bEnable);
-    void setPinchZoom(bool bEnable);
-    void setScrollEasing(float value);
-    void setBounceBack(float value);
-    void setDragVelocityDecay(float value);
-    void setDoubleTapZoom(bool bEnable);
-    void setDoubleTapZoomRangeMin(float value);
-    void setDoubleTapZoomRangeMax(float value);
-    void setDoubleTapZoomIncrement(float value);
-    void setDoubleTapZoomIncrementTimeInSec(float value);
-    void setDoubleTapRegistrationTimeInSec(float value);
-    void setDoubleTapRegistrationDistanceInPixels(float value);
 
     virtual void setup();
     virtual void reset();
     
+    using ofxScrollViewCore::setWindowRect;
+    using ofxScrollViewCore::setContentRect;
     void setWindowRect(const ofRectangle & rect);
     void setContentRect(const ofRectangle & rect);
     
+    using ofxScrollViewCore::fitContentToWindow;
     void fitContentToWindow(ofAspectRatioMode aspectRatioMode);
-
-    void setScale(float value);
-    void setScaleMin(float value);
-    void setScaleMax(float value);
-    
-    float getScale();
-    float getScaleMin();
-    float getScaleMax();
-    
-    void setZoom(float value);
-    float getZoom();
-    bool isZoomed();
-    bool isZoomedInMax();
-    bool isZoomedOutMax();
-    
-    float zoomToScale(float value);
-    float scaleToZoom(float value);
-
+    
+    using ofxScrollViewCore::zoomToMin;
+    using ofxScrollViewCore::zoomToMax;
+    using ofxScrollViewCore::zoomTo;
+    using ofxScrollViewCore::zoomToContentPointAndPositionAtScreenPoint;
+    using ofxScrollViewCore::moveContentPointToScreenPoint;
     void zoomToMin(const ofVec2f & screenPoint, float timeSec=0.0);
     void zoomToMax(const ofVec2f & screenPoint, float timeSec=0.0);
     void zoomTo(const ofVec2f & screenPoint, float zoom, float timeSec=0.0);
@@ -76,11 +73,6 @@ public:
     void moveContentPointToScreenPoint(const ofVec2f & contentPoint,
                                        const ofVec2f & screenPoint,
                                        float timeSec=0.0);
-    bool animStart(float animTimeInSec);
-    
-    void setScrollPositionX(float x, bool bEase=true);
-    void setScrollPositionY(float y, bool bEase=true);
-    void setScrollPosition(float x, float y, bool bEase=true);
     
     ofVec2f getScrollPosition();
     ofVec2f getScrollPositionNorm();
@@ -89,10 +81,25 @@ public:
     const ofRectangle & getContentRect();
     const ofRectangle & getScrollRect();
     const ofMatrix4x4 & getMatrix();
+    ofRectangle getVisibleContentRect();
+    ofRectangle getPredictedScrollRect(int numOfFrames);
+    ofRectangle getPredictedVisibleContentRect(int numOfFrames);
+    
+    virtual void updateEnd();
     
-    virtual void update();
+    ofEvent<ofxScrollViewEventArgs> settledEvent;   // the view came to rest, safe to stop redrawing.
+    ofEvent<ofxScrollViewEventArgs> movingEvent;    // the view started moving again.
+    ofEvent<ofxScrollViewLodEventArgs> lodChangedEvent; // getLodLevel() changed, switch the content representation.
 
     //-------------------------------------------------------------- the brains!
+    using ofxScrollViewCore::getRectContainedInWindowRect;
+    using ofxScrollViewCore::getRectZoomedAtScreenPoint;
+    using ofxScrollViewCore::getRectWithContentPointAtScreenPoint;
+    using ofxScrollViewCore::getRectLerp;
+    using ofxScrollViewCore::getVisibleContentRectForRect;
+    using ofxScrollViewCore::getContentPointAtScreenPoint;
+    using ofxScrollViewCore::getScreenPointAtContentPoint;
+    
     ofRectangle getRectContainedInWindowRect(const ofRectangle & rect,
                                              float easing=1.0);
     
@@ -109,80 +116,101 @@ public:
                             float progress);
     
     ofMatrix4x4 getMatrixForRect(const ofRectangle & rect);
+    ofMatrix4x4 getMatrixForTransform(const ofxScrollViewTransform & transform);
+    
+    ofRectangle getVisibleContentRectForRect(const ofRectangle & rect,
+                                             float margin=0.0);
     
     ofVec2f getContentPointAtScreenPoint(const ofRectangle & rect,
                                          const ofVec2f & screenPoint);
     
     ofVec2f getScreenPointAtContentPoint(const ofRectangle & rect,
                                          const ofVec2f & contentPoint);
+    
+    //-------------------------------------------------------------- batch transforms, dst is resized to match src.
+    using ofxScrollViewCore::getScreenPointsAtContentPoints;
+    using ofxScrollViewCore::getContentPointsAtScreenPoints;
+    void getScreenPointsAtContentPoints(const std::vector<ofVec2f> & contentPoints, std::vector<ofVec2f> & screenPoints);
+    void getContentPointsAtScreenPoints(const std::vector<ofVec2f> & screenPoints, std::vector<ofVec2f> & contentPoints);
+    
+    //-------------------------------------------------------------- content items.
+    using ofxScrollViewCore::addContentItem;
+    using ofxScrollViewCore::moveContentItem;
+    using ofxScrollViewCore::getContentItemAtScreenPoint;
+    void addContentItem(int itemID, const ofRectangle & rect);
+    void moveContentItem(int itemID, const ofRectangle & rect);
+    int getContentItemAtScreenPoint(const ofVec2f & screenPoint);
+    
+    //-------------------------------------------------------------- dirty regions.
+    using ofxScrollViewCore::invalidateContentRect;
+    void invalidateContentRect(const ofRectangle & rect);
+    
+    //-------------------------------------------------------------- core <-> openFrameworks types.
+    static ofRectangle toOf(const ofxScrollViewRect & rect);
+    static ofVec2f toOf(const ofxScrollViewVec2 & point);
+    static ofxScrollViewRect toCore(const ofRectangle & rect);
+    static ofxScrollViewVec2 toCore(const ofVec2f & point);
 
     //--------------------------------------------------------------
     virtual void begin();
     virtual void end();
     virtual void draw();
+    virtual void drawContent(const ofxScrollViewDrawCallback & drawCallback);   // with setLargeWorld(true) the rect and the drawing are relative to getRenderOrigin().
+    
+    //-------------------------------------------------------------- content cache.
+    // when on, drawContent() renders the content once into a grid of fbo tiles and while the view moves
+    // draws those textures under mat instead of calling the draw callback again.
+    // the content is drawn again at full quality once the view settles,
+    // or sooner when the scale drifts past the threshold or the view moves past the cached margin.
+    // invalidateContentRect() redraws only the tiles it touches, the callback gets the tile rect to cull with.
+    void setContentCache(bool bEnable);
+    void setContentCacheMargin(float value);            // pixels cached around the window, default 256.
+    void setContentCacheScaleThreshold(float value);    // relative scale change that redraws while moving, default 0.25.
+    void setContentCacheTileSize(int value);            // tile size in pixels, default 512.
+    void clearContentCache();                           // all the content changed, draw it again next frame.
+    bool isContentCacheEnabled();
     
     virtual void exit();
     
-    virtual void dragDown(const ofVec2f & point);
-    virtual void dragMoved(const ofVec2f & point);
-    virtual void dragUp(const ofVec2f & point);
-    virtual void dragCancel();
-    
-    virtual void zoomDown(const ofVec2f & point, float pointDist);
-    virtual void zoomMoved(const ofVec2f & point, float pointDist);
-    virtual void zoomUp(const ofVec2f & point, float pointDist);
-    virtual void zoomCancel();
-    
-    ofRectangle windowRect;
-    ofRectangle contentRect;
+    virtual void scrollSettled();
+    virtual void scrollMoving();
+    virtual void lodChanged(int lodLevelPrev);
     
     bool bUserInteractionEnabled;
-    bool bPinchZoomEnabled;
-    bool bPinchZoomSupported;
+    ofMatrix4x4 mat;
 
-    ofRectangle scrollRect;
-    ofRectangle scrollRectEased;
-    ofRectangle scrollRectAnim0;
-    ofRectangle scrollRectAnim1;
-    float scrollEasing;
-    float bounceBack;
-    
-    ofVec2f dragDownPos;
-    ofVec2f dragMovePos;
-    ofVec2f dragMovePosPrev;
-    ofVec2f dragVel;
-    float dragVelDecay;
-    bool bDragging;
-    
-    ofVec2f zoomDownPos;
-    ofVec2f zoomMovePos;
-    ofVec2f zoomMovePosPrev;
-    float zoomDownDist;
-    float zoomMoveDist;
-    bool bZooming;
-    
-    float animTimeStart;
-    float animTimeTotal;
-    bool bAnimating;
+protected:
+    
+    bool needsContentCacheRender();
+    void renderContentCache(const ofxScrollViewDrawCallback & drawCallback);
+    void renderContentCacheDirty(const ofxScrollViewDrawCallback & drawCallback);
+    void renderContentCacheTile(int tileIndex, const ofxScrollViewDrawCallback & drawCallback);
+    ofRectangle getContentCacheTileRect(int tileIndex);
+    void drawContentCache();
+    
+    bool bContentCacheEnabled;
+    bool bContentCacheValid;
+    float contentCacheMargin;
+    float contentCacheScaleThreshold;
+    float contentCacheScale;
+    ofRectangle contentCacheRect;   // content space covered by the tiles.
+    int contentCacheTileSize;
+    int contentCacheTileCols;
+    int contentCacheTileRows;
+    std::vector<ofFbo> contentCacheTiles;
+    
+    ofRectangle windowRectOf;       // the core rects as openFrameworks types, for the accessors that return references.
+    ofRectangle contentRectOf;
+    ofRectangle scrollRectOf;
 
-    bool bDoubleTapZoomEnabled;
-    float doubleTapZoomRangeMin;
-    float doubleTapZoomRangeMax;
-    float doubleTapZoomIncrement;
-    float doubleTapZoomIncrementTimeInSec;
-    float doubleTapRegistrationTimeInSec;
-    float doubleTapRegistrationDistanceInPixels;
-    
-    float scale;
-    float scaleDown;
-    float scaleMin;
-    float scaleMax;
-    ofMatrix4x4 mat;
-    
-    vector<ofxScrollViewTouchPoint> touchPoints;
-    ofxScrollViewTouchPoint touchDownPointLast;
+public:
     
     //----------------------------------------------------------
+    using ofxScrollViewCore::mouseMoved;
+    using ofxScrollViewCore::mouseDragged;
+    using ofxScrollViewCore::mousePressed;
+    using ofxScrollViewCore::mouseReleased;
+    
     virtual void mouseMoved(ofMouseEventArgs & mouse){
         mouseMoved(mouse.x,mouse.y);
     }
@@ -196,12 +224,13 @@ public:
         mouseReleased(mouse.x,mouse.y,mouse.button);
     }
     
-    virtual void mouseMoved(int x, int y);
-    virtual void mouseDragged(int x, int y, int button);
-    virtual void mousePressed(int x, int y, int button);
-    virtual void mouseReleased(int x, int y, int button);
-    
     //----------------------------------------------------------
+    using ofxScrollViewCore::touchDown;
+    using ofxScrollViewCore::touchMoved;
+    using ofxScrollViewCore::touchUp;
+    using ofxScrollViewCore::touchDoubleTap;
+    using ofxScrollViewCore::touchCancelled;
+    
 	virtual void touchDown(ofTouchEventArgs &touch) {
         touchDown(touch.x, touch.y, touch.id);
     }
@@ -217,10 +246,4 @@ public:
     virtual void touchCancelled(ofTouchEventArgs &touch) {
         touchCancelled(touch.x, touch.y, touch.id);
     }
-    
-    virtual void touchDown(int x, int y, int id);
-    virtual void touchMoved(int x, int y, int id);
-    virtual void touchUp(int x, int y, int id);
-    virtual void touchDoubleTap(int x, int y, int id);
-    virtual void touchCancelled(int x, int y, int id);
 };
@@ -0,0 +1,319 @@
+//
+//  ofxScrollViewContentIndex.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewContentIndex.h"
+
+//--------------------------------------------------------------
+ofxScrollViewContentIndex::ofxScrollViewContentIndex() {
+    maxItemsPerNode = 8;
+    maxDepth = 8;
+    orderNext = 0;
+    
+    nodes.push_back(ofxScrollViewContentIndexNode());
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewContentIndex::setup(const ofxScrollViewRect & value, int maxItems, int depth) {
+    bounds = value;
+    maxItemsPerNode = (maxItems < 1) ? 1 : maxItems;
+    maxDepth = (depth < 0) ? 0 : depth;
+    
+    rebuild();
+}
+
+void ofxScrollViewContentIndex::setBounds(const ofxScrollViewRect & value) {
+    if(bounds == value) {
+        return;
+    }
+    bounds = value;
+    
+    rebuild();
+}
+
+void ofxScrollViewContentIndex::clear() {
+    nodes.clear();
+    nodes.push_back(ofxScrollViewContentIndexNode());
+    nodes[0].rect = bounds;
+    
+    items.clear();
+    itemSlotsFree.clear();
+    itemSlotsByID.clear();
+    orderNext = 0;
+}
+
+void ofxScrollViewContentIndex::rebuild() {
+    nodes.clear();
+    nodes.push_back(ofxScrollViewContentIndexNode());
+    nodes[0].rect = bounds;
+    
+    for(int i=0; i<items.size(); i++) {
+        if(items[i].itemID == -1) {
+            continue; // free slot.
+        }
+        insertSlot(i);
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewContentIndex::insert(int itemID, const ofxScrollViewRect & rect) {
+    if(itemID < 0) {
+        return;
+    }
+    if(has(itemID) == true) {
+        move(itemID, rect);
+        return;
+    }
+    
+    int itemSlot = items.size();
+    if(itemSlotsFree.size() > 0) {
+        itemSlot = itemSlotsFree.back();
+        itemSlotsFree.pop_back();
+    } else {
+        items.push_back(ofxScrollViewContentItem());
+    }
+    
+    ofxScrollViewContentItem & item = items[itemSlot];
+    item.itemID = itemID;
+    item.rect = rect;
+    item.order = orderNext++;
+    item.nodeIndex = -1;
+    
+    itemSlotsByID[itemID] = itemSlot;
+    insertSlot(itemSlot);
+}
+
+void ofxScrollViewContentIndex::move(int itemID, const ofxScrollViewRect & rect) {
+    std::unordered_map<int, int>::iterator it = itemSlotsByID.find(itemID);
+    if(it == itemSlotsByID.end()) {
+        insert(itemID, rect);
+        return;
+    }
+    
+    int itemSlot = it->second;
+    ofxScrollViewContentItem & item = items[itemSlot];
+    item.rect = rect;
+    
+    // still sits in the same node, nothing to rearrange.
+    const ofxScrollViewContentIndexNode & node = nodes[item.nodeIndex];
+    bool bSameNode = (item.nodeIndex == 0) || contains(node.rect, rect);
+    if(bSameNode == true && node.childIndex != -1) {
+        for(int i=0; i<4; i++) {
+            if(contains(nodes[node.childIndex + i].rect, rect) == true) {
+                bSameNode = false; // fits in a child now.
+                break;
+            }
+        }
+    }
+    if(bSameNode == true) {
+        return;
+    }
+    
+    removeSlotFromNode(itemSlot);
+    insertSlot(itemSlot);
+}
+
+void ofxScrollViewContentIndex::remove(int itemID) {
+    std::unordered_map<int, int>::iterator it = itemSlotsByID.find(itemID);
+    if(it == itemSlotsByID.end()) {
+        return;
+    }
+    
+    int itemSlot = it->second;
+    itemSlotsByID.erase(it);
+    
+    removeSlotFromNode(itemSlot);
+    items[itemSlot] = ofxScrollViewContentItem();
+    itemSlotsFree.push_back(itemSlot);
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewContentIndex::has(int itemID) {
+    return itemSlotsByID.find(itemID) != itemSlotsByID.end();
+}
+
+int ofxScrollViewContentIndex::size() {
+    return itemSlotsByID.size();
+}
+
+const ofxScrollViewRect & ofxScrollViewContentIndex::getBounds() {
+    return bounds;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewContentIndex::getItemsInRect(const ofxScrollViewRect & rect, std::vector<int> & itemIDs) {
+    
+    nodeStack.clear();
+    nodeStack.push_back(0);
+    
+    while(nodeStack.size() > 0) {
+        int nodeIndex = nodeStack.back();
+        nodeStack.pop_back();
+        
+        const ofxScrollViewContentIndexNode & node = nodes[nodeIndex];
+        for(int i=0; i<node.itemSlots.size(); i++) {
+            const ofxScrollViewContentItem & item = items[node.itemSlots[i]];
+            if(intersects(item.rect, rect) == true) {
+                itemIDs.push_back(item.itemID);
+            }
+        }
+        
+        if(node.childIndex == -1) {
+            continue;
+        }
+        for(int i=0; i<4; i++) {
+            if(intersects(nodes[node.childIndex + i].rect, rect) == true) {
+                nodeStack.push_back(node.childIndex + i);
+            }
+        }
+    }
+}
+
+int ofxScrollViewContentIndex::getItemAtPoint(ofxScrollViewScalar x, ofxScrollViewScalar y) {
+    
+    ofxScrollViewRect pointRect(x, y, 0, 0);
+    int itemID = -1;
+    unsigned int itemOrder = 0;
+    
+    nodeStack.clear();
+    nodeStack.push_back(0);
+    
+    // the point only falls inside more than one child when it sits right on a split line.
+    while(nodeStack.size() > 0) {
+        int nodeIndex = nodeStack.back();
+        nodeStack.pop_back();
+        
+        const ofxScrollViewContentIndexNode & node = nodes[nodeIndex];
+        for(int i=0; i<node.itemSlots.size(); i++) {
+            const ofxScrollViewContentItem & item = items[node.itemSlots[i]];
+            if(intersects(item.rect, pointRect) == false) {
+                continue;
+            }
+            if(itemID == -1 || item.order > itemOrder) {
+                itemID = item.itemID;
+                itemOrder = item.order;
+            }
+        }
+        
+        if(node.childIndex == -1) {
+            continue;
+        }
+        for(int i=0; i<4; i++) {
+            if(intersects(nodes[node.childIndex + i].rect, pointRect) == true) {
+                nodeStack.push_back(node.childIndex + i);
+            }
+        }
+    }
+    
+    return itemID;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewContentIndex::intersects(const ofxScrollViewRect & a, const ofxScrollViewRect & b) {
+    bool bIntersects = true;
+    bIntersects = bIntersects && (a.x <= b.x + b.width);
+    bIntersects = bIntersects && (b.x <= a.x + a.width);
+    bIntersects = bIntersects && (a.y <= b.y + b.height);
+    bIntersects = bIntersects && (b.y <= a.y + a.height);
+    return bIntersects;
+}
+
+bool ofxScrollViewContentIndex::contains(const ofxScrollViewRect & outer, const ofxScrollViewRect & inner) {
+    bool bContains = true;
+    bContains = bContains && (inner.x >= outer.x);
+    bContains = bContains && (inner.y >= outer.y);
+    bContains = bContains && (inner.x + inner.width <= outer.x + outer.width);
+    bContains = bContains && (inner.y + inner.height <= outer.y + outer.height);
+    return bContains;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewContentIndex::insertSlot(int itemSlot) {
+    
+    const ofxScrollViewRect & rect = items[itemSlot].rect;
+    
+    // walk down to the smallest node that holds the whole rect.
+    // items outside the bounds stay in the root.
+    int nodeIndex = 0;
+    while(true) {
+        ofxScrollViewContentIndexNode & node = nodes[nodeIndex];
+        
+        if(node.childIndex == -1) {
+            if(node.itemSlots.size() < maxItemsPerNode || node.depth >= maxDepth) {
+                break;
+            }
+            split(nodeIndex);
+        }
+        
+        int childIndex = nodes[nodeIndex].childIndex;
+        int childFound = -1;
+        for(int i=0; i<4; i++) {
+            if(contains(nodes[childIndex + i].rect, rect) == true) {
+                childFound = childIndex + i;
+                break;
+            }
+        }
+        if(childFound == -1) {
+            break; // straddles the children.
+        }
+        nodeIndex = childFound;
+    }
+    
+    nodes[nodeIndex].itemSlots.push_back(itemSlot);
+    items[itemSlot].nodeIndex = nodeIndex;
+}
+
+void ofxScrollViewContentIndex::removeSlotFromNode(int itemSlot) {
+    int nodeIndex = items[itemSlot].nodeIndex;
+    if(nodeIndex == -1) {
+        return;
+    }
+    
+    std::vector<int> & itemSlots = nodes[nodeIndex].itemSlots;
+    for(int i=0; i<itemSlots.size(); i++) {
+        if(itemSlots[i] == itemSlot) {
+            itemSlots[i] = itemSlots.back();
+            itemSlots.pop_back();
+            break;
+        }
+    }
+    items[itemSlot].nodeIndex = -1;
+}
+
+void ofxScrollViewContentIndex::split(int nodeIndex) {
+    
+    int childIndex = nodes.size();
+    ofxScrollViewRect rect = nodes[nodeIndex].rect;
+    int depth = nodes[nodeIndex].depth + 1;
+    ofxScrollViewScalar w = rect.width * 0.5;
+    ofxScrollViewScalar h = rect.height * 0.5;
+    
+    for(int i=0; i<4; i++) {
+        ofxScrollViewContentIndexNode child;
+        child.rect.x = rect.x + ((i % 2 == 0) ? 0 : w);
+        child.rect.y = rect.y + ((i < 2) ? 0 : h);
+        child.rect.width = w;
+        child.rect.height = h;
+        child.depth = depth;
+        nodes.push_back(child); // may reallocate, so no node references held across this.
+    }
+    nodes[nodeIndex].childIndex = childIndex;
+    
+    // push down the items that now fit inside a child.
+    std::vector<int> itemSlots;
+    itemSlots.swap(nodes[nodeIndex].itemSlots);
+    for(int i=0; i<itemSlots.size(); i++) {
+        int itemSlot = itemSlots[i];
+        int childFound = nodeIndex;
+        for(int j=0; j<4; j++) {
+            if(contains(nodes[childIndex + j].rect, items[itemSlot].rect) == true) {
+                childFound = childIndex + j;
+                break;
+            }
+        }
+        nodes[childFound].itemSlots.push_back(itemSlot);
+        items[itemSlot].nodeIndex = childFound;
+    }
+}
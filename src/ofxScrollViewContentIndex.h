@@ -0,0 +1,86 @@
+//
+//  ofxScrollViewContentIndex.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  quadtree of item rects placed inside the content rect.
+//  finds the items inside a rect, eg. the visible content rect, or under a point
+//  without looping over every item.
+//
+
+#pragma once
+
+#include "ofxScrollViewTypes.h"
+#include <vector>
+#include <unordered_map>
+
+//--------------------------------------------------------------
+class ofxScrollViewContentItem {
+public:
+    ofxScrollViewContentItem() {
+        itemID = -1;
+        order = 0;
+        nodeIndex = -1;
+    }
+    int itemID;
+    ofxScrollViewRect rect;
+    unsigned int order;     // items added later are on top when hit testing.
+    int nodeIndex;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewContentIndexNode {
+public:
+    ofxScrollViewContentIndexNode() {
+        childIndex = -1;
+        depth = 0;
+    }
+    ofxScrollViewRect rect;
+    int childIndex;         // first of four children, -1 when a leaf.
+    int depth;
+    std::vector<int> itemSlots;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewContentIndex {
+
+public:
+    
+    ofxScrollViewContentIndex();
+    
+    void setup(const ofxScrollViewRect & bounds, int maxItemsPerNode=8, int maxDepth=8);
+    void setBounds(const ofxScrollViewRect & bounds);
+    void clear();
+    
+    void insert(int itemID, const ofxScrollViewRect & rect);   // item ids are zero or above.
+    void move(int itemID, const ofxScrollViewRect & rect);
+    void remove(int itemID);
+    
+    bool has(int itemID);
+    int size();
+    const ofxScrollViewRect & getBounds();
+    
+    void getItemsInRect(const ofxScrollViewRect & rect, std::vector<int> & itemIDs);   // appends to itemIDs.
+    int getItemAtPoint(ofxScrollViewScalar x, ofxScrollViewScalar y);                                               // topmost, -1 when none.
+    
+    static bool intersects(const ofxScrollViewRect & a, const ofxScrollViewRect & b);
+    static bool contains(const ofxScrollViewRect & outer, const ofxScrollViewRect & inner);
+
+protected:
+    
+    void insertSlot(int itemSlot);
+    void removeSlotFromNode(int itemSlot);
+    void split(int nodeIndex);
+    void rebuild();
+    
+    ofxScrollViewRect bounds;
+    int maxItemsPerNode;
+    int maxDepth;
+    unsigned int orderNext;
+    
+    std::vector<ofxScrollViewContentIndexNode> nodes;
+    std::vector<ofxScrollViewContentItem> items;
+    std::vector<int> itemSlotsFree;
+    std::unordered_map<int, int> itemSlotsByID;
+    std::vector<int> nodeStack;
+};
@@ -0,0 +1,1708 @@
+//
+//  ofxScrollViewCore.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewCore.h"
+#include "ofxScrollViewInputRecord.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+//--------------------------------------------------------------
+static float const kEasingStop = 0.001;
+
+//-------------------------------------------------------------- same behaviour as ofClamp and ofMap.
+static inline ofxScrollViewScalar clampf(ofxScrollViewScalar value, ofxScrollViewScalar min, ofxScrollViewScalar max) {
+    return value < min ? min : value > max ? max : value;
+}
+
+static inline ofxScrollViewScalar mapf(ofxScrollViewScalar value, ofxScrollViewScalar inputMin, ofxScrollViewScalar inputMax, ofxScrollViewScalar outputMin, ofxScrollViewScalar outputMax, bool bClamp=false) {
+    if(std::abs(inputMin - inputMax) < FLT_EPSILON) {
+        return outputMin;
+    }
+    ofxScrollViewScalar outVal = ((value - inputMin) / (inputMax - inputMin) * (outputMax - outputMin) + outputMin);
+    if(bClamp == true) {
+        if(outputMax < outputMin) {
+            outVal = clampf(outVal, outputMax, outputMin);
+        } else {
+            outVal = clampf(outVal, outputMin, outputMax);
+        }
+    }
+    return outVal;
+}
+
+static inline ofxScrollViewScalar minf(ofxScrollViewScalar a, ofxScrollViewScalar b) {
+    return a < b ? a : b;
+}
+
+static inline ofxScrollViewScalar maxf(ofxScrollViewScalar a, ofxScrollViewScalar b) {
+    return a > b ? a : b;
+}
+
+//--------------------------------------------------------------
+static int const kDirtyContentRectsMax = 16;
+
+static inline ofxScrollViewRect getRectUnion(const ofxScrollViewRect & a, const ofxScrollViewRect & b) {
+    ofxScrollViewScalar x0 = minf(a.x, b.x);
+    ofxScrollViewScalar y0 = minf(a.y, b.y);
+    ofxScrollViewScalar x1 = maxf(a.x + a.width, b.x + b.width);
+    ofxScrollViewScalar y1 = maxf(a.y + a.height, b.y + b.height);
+    return ofxScrollViewRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+static inline ofxScrollViewRect getRectIntersection(const ofxScrollViewRect & a, const ofxScrollViewRect & b) {
+    ofxScrollViewScalar x0 = maxf(a.x, b.x);
+    ofxScrollViewScalar y0 = maxf(a.y, b.y);
+    ofxScrollViewScalar x1 = minf(a.x + a.width, b.x + b.width);
+    ofxScrollViewScalar y1 = minf(a.y + a.height, b.y + b.height);
+    if(x1 <= x0 || y1 <= y0) {
+        return ofxScrollViewRect();
+    }
+    return ofxScrollViewRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+//--------------------------------------------------------------
+static int const kInputSourcesMax = 8;
+
+//--------------------------------------------------------------
+static double getSteadyTimeInSec() {
+    static std::chrono::steady_clock::time_point const timeStart = std::chrono::steady_clock::now();
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - timeStart;
+    return time.count();
+}
+
+//--------------------------------------------------------------
+ofxScrollViewCore::ofxScrollViewCore() {
+    
+    clock = getSteadyTimeInSec;
+    inputRecorder = NULL;
+    inputEventTimeInSec = -1;
+    setInputSources(1);
+    
+    bPinchZoomEnabled = false;
+    bPinchZoomSupported = false;
+    
+    scrollEasing = 0.5;
+    bounceBack = 1.0;
+    visibleContentMargin = 0.0;
+    
+    dragVelDecay = 0.9;
+    bDragging = false;
+    
+    inputVelocityWindowInSec = 0.1;
+    inputPredictionInSec = 0.0;
+    
+    zoomDownDist = 0;
+    zoomMoveDist = 0;
+    bZooming = false;
+    
+    timeStepInSec = 1.0 / 60.0; // scrollEasing, bounceBack and dragVelDecay are tuned for 60 fps.
+    maxStepsPerUpdate = 4;
+    timeLast = -1;
+    timeDelta = 0;
+    timeAccumulated = 0;
+    numOfSteps = 0;
+    stepProgress = 1.0;
+    
+    animTimeStart = 0.0;
+    animTimeTotal = 0.0;
+    bAnimating = false;
+    
+    bDoubleTapZoomEnabled = false;
+    doubleTapZoomRangeMin = 0.0;
+    doubleTapZoomRangeMax = 1.0;
+    doubleTapZoomIncrement = 1.0;
+    doubleTapZoomIncrementTimeInSec = 0.2;
+    doubleTapRegistrationTimeInSec = 0.25;
+    doubleTapRegistrationDistanceInPixels = 22;
+    
+    scale = 1.0;
+    scaleDown = 1.0;
+    scaleMin = 1.0;
+    scaleMax = 1.0;
+    
+    bLargeWorld = false;
+    bRenderOriginChanged = false;
+    
+    lodThresholds.push_back(0.25);
+    lodThresholds.push_back(0.5);
+    lodThresholds.push_back(0.75);
+    lodHysteresis = 0.02;
+    lodLevel = 0;
+    bLodLevelChanged = false;
+    
+    bSettled = false;
+    bNeedsRedraw = true;
+    bRedrawRequested = true;
+    
+    setPinchZoom(true);
+    setDoubleTapZoom(true);
+}
+
+ofxScrollViewCore::~ofxScrollViewCore() {
+    //
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setClock(const ofxScrollViewClock & value) {
+    clock = value;
+}
+
+double ofxScrollViewCore::getTimeInSec() {
+    return clock();
+}
+
+void ofxScrollViewCore::setInputRecorder(ofxScrollViewInputRecorder * recorder) {
+    inputRecorder = recorder;
+}
+
+ofxScrollViewStats & ofxScrollViewCore::getStats() {
+    return stats;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setPinchZoom(bool value) {
+    bPinchZoomEnabled = value;
+}
+
+void ofxScrollViewCore::setPinchZoomSupported(bool value) {
+    bPinchZoomSupported = value;
+}
+
+void ofxScrollViewCore::setScrollEasing(float value) {
+    scrollEasing = value;
+}
+
+void ofxScrollViewCore::setBounceBack(float value) {
+    bounceBack = value;
+}
+
+void ofxScrollViewCore::setDragVelocityDecay(float value) {
+    dragVelDecay = value;
+}
+
+void ofxScrollViewCore::setDoubleTapZoom(bool value) {
+    bDoubleTapZoomEnabled = value;
+}
+
+void ofxScrollViewCore::setDoubleTapZoomRangeMin(ofxScrollViewScalar value) {
+    doubleTapZoomRangeMin = value;
+}
+
+void ofxScrollViewCore::setDoubleTapZoomRangeMax(ofxScrollViewScalar value) {
+    doubleTapZoomRangeMax = value;
+}
+
+void ofxScrollViewCore::setDoubleTapZoomIncrement(ofxScrollViewScalar value) {
+    doubleTapZoomIncrement = value;
+}
+
+void ofxScrollViewCore::setDoubleTapZoomIncrementTimeInSec(float value) {
+    doubleTapZoomIncrementTimeInSec = value;
+}
+
+void ofxScrollViewCore::setDoubleTapRegistrationTimeInSec(float value) {
+    doubleTapRegistrationTimeInSec = value;
+}
+
+void ofxScrollViewCore::setDoubleTapRegistrationDistanceInPixels(float value) {
+    doubleTapRegistrationDistanceInPixels = value;
+}
+
+void ofxScrollViewCore::setVisibleContentMargin(float value) {
+    visibleContentMargin = value;
+}
+
+void ofxScrollViewCore::setTimeStep(float value) {
+    timeStepInSec = maxf(value, 0.0);
+    timeAccumulated = 0;
+}
+
+void ofxScrollViewCore::setInputVelocityWindow(float value) {
+    inputVelocityWindowInSec = value;
+}
+
+void ofxScrollViewCore::setInputPrediction(float value) {
+    inputPredictionInSec = value;
+}
+
+void ofxScrollViewCore::setMaxStepsPerUpdate(int value) {
+    maxStepsPerUpdate = (value < 1) ? 1 : value;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setup() {
+    if(contentRect.isEmpty() == true) {
+        setContentRect(windowRect);
+    }
+    
+    reset();
+}
+
+void ofxScrollViewCore::reset() {
+    touchPoints.clear();
+    
+    dragDownPos.set(0);
+    dragMovePos.set(0);
+    dragMovePosPrev.set(0);
+    dragVel.set(0);
+    bDragging = false;
+    inputQueue.clear();
+    
+    zoomDownPos.set(0);
+    zoomMovePos.set(0);
+    zoomMovePosPrev.set(0);
+    bZooming = false;
+    
+    animTimeStart = 0.0;
+    animTimeTotal = 0.0;
+    bAnimating = false;
+    
+    scale = scaleMin;
+    scaleDown = scaleMin;
+    
+    scrollRect.width = scrollRectEased.width = contentRect.width * scale;
+    scrollRect.height = scrollRectEased.height = contentRect.height * scale;
+    scrollRect = scrollRectEased = getRectContainedInWindowRect(scrollRect);
+    scrollRectEasedPrev = scrollRectInterpolated = scrollRectEased;
+    
+    timeLast = -1;
+    timeAccumulated = 0;
+    
+    transform = getTransformForRect(scrollRect);
+    updateRenderOrigin();
+    updateLod(false);
+    
+    setNeedsRedraw();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setWindowRect(const ofxScrollViewRect & rect) {
+    if(windowRect == rect) {
+        return;
+    }
+    windowRect = rect;
+}
+
+void ofxScrollViewCore::setContentRect(const ofxScrollViewRect & rect) {
+    if(contentRect == rect) {
+        return;
+    }
+    contentRect = rect;
+    
+    contentIndex.setBounds(ofxScrollViewRect(0, 0, contentRect.width, contentRect.height));
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::fitContentToWindow(ofxScrollViewAspectRatioMode aspectRatioMode) {
+    ofxScrollViewScalar sx = windowRect.width / contentRect.width;
+    ofxScrollViewScalar sy = windowRect.height / contentRect.height;
+    
+    if(aspectRatioMode == OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP) {
+        scaleMin = minf(sx, sy);
+    } else if(aspectRatioMode == OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP_BY_EXPANDING) {
+        scaleMin = maxf(sx, sy);
+    } else {
+        scaleMin = 1.0;
+    }
+    
+    scaleMin = minf(scaleMin, 1.0);
+    scaleMax = 1.0;
+    scale = scaleMin;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setScale(ofxScrollViewScalar value) {
+    scale = value;
+    scale = clampf(scale, scaleMin, scaleMax);
+}
+
+void ofxScrollViewCore::setScaleMin(ofxScrollViewScalar value) {
+    scaleMin = value;
+    scale = clampf(scale, scaleMin, scaleMax);
+}
+
+void ofxScrollViewCore::setScaleMax(ofxScrollViewScalar value) {
+    scaleMax = value;
+    scale = clampf(scale, scaleMin, scaleMax);
+}
+
+//--------------------------------------------------------------
+ofxScrollViewScalar ofxScrollViewCore::getScale() {
+    return scale;
+}
+
+ofxScrollViewScalar ofxScrollViewCore::getScaleMin() {
+    return scaleMin;
+}
+
+ofxScrollViewScalar ofxScrollViewCore::getScaleMax() {
+    return scaleMax;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setZoom(ofxScrollViewScalar value) {
+    ofxScrollViewScalar zoom = clampf(value, 0.0, 1.0);
+    scale = zoomToScale(zoom);
+}
+
+ofxScrollViewScalar ofxScrollViewCore::getZoom() {
+    ofxScrollViewScalar zoom = scaleToZoom(scale);
+    return zoom;
+}
+
+bool ofxScrollViewCore::isZoomed() {
+    ofxScrollViewScalar zoom = getZoom();
+    return (zoom > 0.0);
+}
+
+bool ofxScrollViewCore::isZoomedInMax() {
+    ofxScrollViewScalar zoom = getZoom();
+    return (zoom == 1.0);
+}
+
+bool ofxScrollViewCore::isZoomedOutMax() {
+    ofxScrollViewScalar zoom = getZoom();
+    return (zoom == 0.0);
+}
+
+//--------------------------------------------------------------
+ofxScrollViewScalar ofxScrollViewCore::zoomToScale(ofxScrollViewScalar value) {
+    if(scaleMin == scaleMax) {
+        return scaleMin;
+    }
+    return mapf(value, 0.0, 1.0, scaleMin, scaleMax, true);
+}
+
+ofxScrollViewScalar ofxScrollViewCore::scaleToZoom(ofxScrollViewScalar value) {
+    if(scaleMin == scaleMax) {
+        return 0.0;
+    }
+    return mapf(value, scaleMin, scaleMax, 0.0, 1.0, true);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::zoomToMin(const ofxScrollViewVec2 & screenPoint, float timeSec) {
+    zoomTo(screenPoint, scaleMin, timeSec);
+}
+
+void ofxScrollViewCore::zoomToMax(const ofxScrollViewVec2 & screenPoint, float timeSec) {
+    zoomTo(screenPoint, scaleMax, timeSec);
+}
+
+void ofxScrollViewCore::zoomTo(const ofxScrollViewVec2 & screenPoint, ofxScrollViewScalar zoom, float timeSec) {
+    bool bAnimate = animStart(timeSec);
+    
+    scrollRectAnim0 = scrollRect;
+    scrollRectAnim1 = scrollRect;
+    scrollRectAnim1 = getRectZoomedAtScreenPoint(scrollRectAnim1, screenPoint, zoom);
+    scrollRectAnim1 = getRectContainedInWindowRect(scrollRectAnim1);
+    
+    if(bAnimate == false) {
+        scrollRect = scrollRectEased = scrollRectAnim1;
+        scrollRectEasedPrev = scrollRectInterpolated = scrollRectEased;
+    }
+}
+
+void ofxScrollViewCore::zoomToContentPointAndPositionAtScreenPoint(const ofxScrollViewVec2 & contentPoint,
+                                                                   const ofxScrollViewVec2 & screenPoint,
+                                                                   ofxScrollViewScalar zoom,
+                                                                   float timeSec) {
+    bool bAnimate = animStart(timeSec);
+    
+    scrollRectAnim0 = scrollRect;
+    scrollRectAnim1 = scrollRect;
+    scrollRectAnim1 = getRectWithContentPointAtScreenPoint(scrollRectAnim1, contentPoint, screenPoint);
+    scrollRectAnim1 = getRectZoomedAtScreenPoint(scrollRectAnim1, screenPoint, zoom);
+    scrollRectAnim1 = getRectContainedInWindowRect(scrollRectAnim1);
+    
+    if(bAnimate == false) {
+        scrollRect = scrollRectEased = scrollRectAnim1;
+        scrollRectEasedPrev = scrollRectInterpolated = scrollRectEased;
+    }
+}
+
+void ofxScrollViewCore::moveContentPointToScreenPoint(const ofxScrollViewVec2 & contentPoint,
+                                                      const ofxScrollViewVec2 & screenPoint,
+                                                      float timeSec) {
+    bool bAnimate = animStart(timeSec);
+    
+    scrollRectAnim0 = scrollRect;
+    scrollRectAnim1 = scrollRect;
+    scrollRectAnim1 = getRectWithContentPointAtScreenPoint(scrollRectAnim1, contentPoint, screenPoint);
+    
+    if(bAnimate == false) {
+        scrollRect = scrollRectEased = scrollRectAnim1;
+        scrollRectEasedPrev = scrollRectInterpolated = scrollRectEased;
+    }
+}
+
+bool ofxScrollViewCore::animStart(float animTimeInSec) {
+    bAnimating = true;
+    
+    animTimeStart = getTimeInSec();
+    animTimeTotal = maxf(animTimeInSec, 0.0);
+    
+    if(animTimeTotal < 0.001) {
+        animTimeTotal = 0;
+        bAnimating = false;
+    }
+    
+    return bAnimating;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setScrollPositionX(ofxScrollViewScalar x, bool bEase) {
+    dragCancel();
+    zoomCancel();
+    
+    ofxScrollViewScalar px = clampf(x, 0.0, 1.0);
+    scrollRect.x = windowRect.x - (scrollRect.width - windowRect.width) * px;
+    if(bEase == false) {
+        scrollRectEased.x = scrollRectEasedPrev.x = scrollRectInterpolated.x = scrollRect.x;
+    }
+}
+
+void ofxScrollViewCore::setScrollPositionY(ofxScrollViewScalar y, bool bEase) {
+    dragCancel();
+    zoomCancel();
+    
+    ofxScrollViewScalar py = clampf(y, 0.0, 1.0);
+    scrollRect.y = windowRect.y - (scrollRect.height - windowRect.height) * py;
+    if(bEase == false) {
+        scrollRectEased.y = scrollRectEasedPrev.y = scrollRectInterpolated.y = scrollRect.y;
+    }
+}
+
+void ofxScrollViewCore::setScrollPosition(ofxScrollViewScalar x, ofxScrollViewScalar y, bool bEase) {
+    setScrollPositionX(x, bEase);
+    setScrollPositionY(y, bEase);
+}
+
+ofxScrollViewVec2 ofxScrollViewCore::getScrollPosition() {
+    return ofxScrollViewVec2(scrollRectInterpolated.x, scrollRectInterpolated.y);
+}
+
+ofxScrollViewVec2 ofxScrollViewCore::getScrollPositionNorm() {
+    ofxScrollViewVec2 scrollPosEasedNorm;
+    
+    ofxScrollViewScalar dx = windowRect.width - scrollRect.width;
+    ofxScrollViewScalar dy = windowRect.height - scrollRect.height;
+    if(dx >= 0) {
+        scrollPosEasedNorm.x = 0;
+    } else {
+        scrollPosEasedNorm.x = mapf(scrollRectInterpolated.x, dx, 0.0, 1.0, 0.0, true);
+    }
+    if(dy >= 0) {
+        scrollPosEasedNorm.y = 0;
+    } else {
+        scrollPosEasedNorm.y = mapf(scrollRectInterpolated.y, dy, 0.0, 1.0, 0.0, true);
+    }
+    
+    return scrollPosEasedNorm;
+}
+
+//--------------------------------------------------------------
+const ofxScrollViewRect & ofxScrollViewCore::getWindowRect() {
+    return windowRect;
+}
+
+const ofxScrollViewRect & ofxScrollViewCore::getContentRect() {
+    return contentRect;
+}
+
+const ofxScrollViewRect & ofxScrollViewCore::getScrollRect() {
+    return scrollRect;
+}
+
+const ofxScrollViewTransform & ofxScrollViewCore::getTransform() {
+    return transform;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getVisibleContentRect() {
+    return getVisibleContentRectForRect(scrollRectInterpolated, visibleContentMargin);
+}
+
+ofxScrollViewRect ofxScrollViewCore::getPredictedScrollRect(int numOfFrames) {
+    
+    // where scrollRect will be in numOfFrames if no new input arrives.
+    
+    if(bAnimating == true) {
+        return scrollRectAnim1;
+    }
+    
+    if(bZooming == true || numOfFrames <= 0) {
+        return scrollRect;
+    }
+    
+    float frames = numOfFrames;
+    if(bDragging == false) {
+        // sum of the decaying velocity over the next numOfFrames updates.
+        float decay = dragVelDecay;
+        if(decay < 1.0) {
+            frames = decay * (1.0 - powf(decay, numOfFrames)) / (1.0 - decay);
+        }
+    }
+    
+    ofxScrollViewRect rect = scrollRect;
+    rect.x += dragVel.x * frames;
+    rect.y += dragVel.y * frames;
+    rect = getRectContainedInWindowRect(rect);
+    
+    return rect;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getPredictedVisibleContentRect(int numOfFrames) {
+    return getVisibleContentRectForRect(getPredictedScrollRect(numOfFrames), visibleContentMargin);
+}
+
+ofxScrollViewInputQueue & ofxScrollViewCore::getInputQueue() {
+    return inputQueue;
+}
+
+ofxScrollViewVec2 ofxScrollViewCore::getInputVelocity() {
+    ofxScrollViewVec2 velocity;
+    if(inputQueue.getVelocity(timeLast, inputVelocityWindowInSec, velocity) == false) {
+        return ofxScrollViewVec2();
+    }
+    return velocity;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::update() {
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_UPDATE);
+    updateTime();
+    updateInput();
+    for(int i=0; i<numOfSteps; i++) {
+        updateStep();
+    }
+    updateEnd();
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_UPDATE);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::updateTime() {
+    
+    //==========================================================
+    // work out how many fixed steps to run this update.
+    //==========================================================
+    
+    // posted input goes first so a recording has it ahead of the update it was handled in.
+    updateInputSources();
+    
+    double timeNow = getTimeInSec();
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_UPDATE, timeNow);
+    }
+    timeDelta = (timeLast < 0) ? 0.0 : maxf(timeNow - timeLast, 0.0);
+    timeLast = timeNow;
+    
+    numOfSteps = 1;
+    stepProgress = 1.0;
+    
+    if(timeStepInSec > 0) {
+        
+        timeAccumulated += (timeDelta > 0) ? timeDelta : timeStepInSec; // a clock that isn't moving still steps once per update.
+        numOfSteps = (int)(timeAccumulated / timeStepInSec);
+        if(numOfSteps > maxStepsPerUpdate) {
+            // after a hitch, drop the time we can't catch up on instead of spiralling.
+            numOfSteps = maxStepsPerUpdate;
+            timeAccumulated = numOfSteps * timeStepInSec;
+        }
+        timeAccumulated -= numOfSteps * timeStepInSec;
+        stepProgress = timeAccumulated / timeStepInSec;
+    }
+}
+
+void ofxScrollViewCore::updateInput() {
+    
+    if(bAnimating == true) {
+        
+        stats.beginPhase(OFX_SCROLL_VIEW_PHASE_ANIMATION);
+        
+        float progress = mapf(timeLast - animTimeStart, 0.0, animTimeTotal, 0.0, 1.0, true);
+        bAnimating = (progress < 1.0);
+        
+        ofxScrollViewRect rect = getRectLerp(scrollRectAnim0, scrollRectAnim1, progress);
+        scrollRect = rect;
+        
+        scale = scrollRect.width / contentRect.width;
+        
+        stats.endPhase(OFX_SCROLL_VIEW_PHASE_ANIMATION);
+        
+    } else {
+        
+        //==========================================================
+        // dragging.
+        // the finger is followed once per update, from the newest sample
+        // or from where it's predicted to be when this frame is shown.
+        // dragVel is fitted over all the samples in the velocity window, not just the last two,
+        // and kept per step so a fling carries the same speed at any frame rate.
+        //==========================================================
+        
+        if(bDragging == true || bZooming == true) {
+            
+            stats.beginPhase(OFX_SCROLL_VIEW_PHASE_DRAG);
+            
+            ofxScrollViewVec2 dragDelta;
+            
+            if(bDragging == true) {
+                
+                ofxScrollViewVec2 dragPos = dragMovePos;
+                if(inputPredictionInSec > 0) {
+                    dragPos = inputQueue.getPredictedPosition(timeLast, inputPredictionInSec, inputVelocityWindowInSec);
+                }
+                dragDelta = dragPos - dragMovePosPrev;
+                dragMovePosPrev = dragPos;
+                
+            } else if(bZooming == true) {
+                
+                dragDelta = zoomMovePos - zoomMovePosPrev;
+                zoomMovePosPrev = zoomMovePos;
+            }
+            
+            ofxScrollViewVec2 inputVel;
+            if(getInputVelocityPerStep(timeLast, inputVel) == true) {
+                dragVel = inputVel;
+            } else if(timeStepInSec > 0 && timeDelta > 0) {
+                dragVel = dragDelta * (timeStepInSec / timeDelta);
+            } else {
+                dragVel = dragDelta;
+            }
+            
+            scrollRect.x += dragDelta.x;
+            scrollRect.y += dragDelta.y;
+            
+            stats.endPhase(OFX_SCROLL_VIEW_PHASE_DRAG);
+        }
+        
+        //==========================================================
+        // zooming.
+        //==========================================================
+        
+        if(bZooming == true) {
+            
+            stats.beginPhase(OFX_SCROLL_VIEW_PHASE_ZOOM);
+            
+            float zoomUnitDist = ofxScrollViewVec2(windowRect.width, windowRect.height).length(); // diagonal.
+            ofxScrollViewScalar zoomRange = scaleMax - scaleMin;
+            ofxScrollViewScalar zoomDiff = 0;
+            ofxScrollViewScalar zoom = 0;
+            
+            if(bPinchZoomSupported == true && bLargeWorld == true) {
+                
+                // relative, the fingers doubling their distance doubles the scale.
+                if(zoomDownDist > 0) {
+                    zoom = scaleDown * (zoomMoveDist / zoomDownDist) - scaleDown;
+                }
+                
+            } else {
+                
+                if(bPinchZoomSupported == true) {
+                    
+                    zoomDiff = zoomMoveDist - zoomDownDist;
+                    zoomDiff *= 4;
+                    
+                } else {
+                    
+                    zoomDiff = zoomMovePos.x - zoomDownPos.x;
+                }
+                
+                zoom = mapf(zoomDiff, -zoomUnitDist, zoomUnitDist, -zoomRange, zoomRange, true);
+            }
+            
+            scale = scaleDown + zoom;
+            scale = maxf(scale, 0.0);
+            
+            if(scale < scaleMin) {
+                scale = scaleMin;
+            } else if(scale > scaleMax) {
+                scale = scaleMax;
+            }
+            
+            ofxScrollViewScalar zoomScale = scaleToZoom(scale);
+            ofxScrollViewRect rect = getRectZoomedAtScreenPoint(scrollRect, zoomMovePos, zoomScale);
+            scrollRect = rect;
+            
+            stats.endPhase(OFX_SCROLL_VIEW_PHASE_ZOOM);
+        }
+    }
+}
+
+void ofxScrollViewCore::updateStep() {
+    
+    scrollRectEasedPrev = scrollRectEased;
+    
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_EASING);
+    
+    //==========================================================
+    // fling.
+    //==========================================================
+    
+    if(bAnimating == false && bDragging == false && bZooming == false) {
+        
+        dragVel *= dragVelDecay;
+        if(std::abs(dragVel.x) < kEasingStop) {
+            dragVel.x = 0;
+        }
+        if(std::abs(dragVel.y) < kEasingStop) {
+            dragVel.y = 0;
+        }
+        bool bAddVel = true;
+        bAddVel = bAddVel && (std::abs(dragVel.x) > 0);
+        bAddVel = bAddVel && (std::abs(dragVel.y) > 0);
+        if(bAddVel == true) {
+            scrollRect.x += dragVel.x;
+            scrollRect.y += dragVel.y;
+        }
+    }
+    
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_EASING);
+    
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_CONTAINMENT);
+    scrollRect = getRectContainedInWindowRect(scrollRect, bounceBack);
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_CONTAINMENT);
+    
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_EASING);
+    
+    //==========================================================
+    // apply easing to scrollRect.
+    //==========================================================
+    
+    scrollRectEased.x += (scrollRect.x - scrollRectEased.x) * scrollEasing;
+    scrollRectEased.y += (scrollRect.y - scrollRectEased.y) * scrollEasing;
+    scrollRectEased.width += (scrollRect.width - scrollRectEased.width) * scrollEasing;
+    scrollRectEased.height += (scrollRect.height - scrollRectEased.height) * scrollEasing;
+    
+    if(std::abs(scrollRect.x - scrollRectEased.x) < kEasingStop) {
+        scrollRectEased.x = scrollRect.x;
+    }
+    if(std::abs(scrollRect.y - scrollRectEased.y) < kEasingStop) {
+        scrollRectEased.y = scrollRect.y;
+    }
+    if(std::abs(scrollRect.width - scrollRectEased.width) < kEasingStop) {
+        scrollRectEased.width = scrollRect.width;
+    }
+    if(std::abs(scrollRect.height - scrollRectEased.height) < kEasingStop) {
+        scrollRectEased.height = scrollRect.height;
+    }
+    
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_EASING);
+}
+
+void ofxScrollViewCore::updateEnd() {
+    
+    //==========================================================
+    // interpolate between the last two steps for drawing.
+    //==========================================================
+    
+    scrollRectInterpolated.x = scrollRectEasedPrev.x + (scrollRectEased.x - scrollRectEasedPrev.x) * stepProgress;
+    scrollRectInterpolated.y = scrollRectEasedPrev.y + (scrollRectEased.y - scrollRectEasedPrev.y) * stepProgress;
+    scrollRectInterpolated.width = scrollRectEasedPrev.width + (scrollRectEased.width - scrollRectEasedPrev.width) * stepProgress;
+    scrollRectInterpolated.height = scrollRectEasedPrev.height + (scrollRectEased.height - scrollRectEasedPrev.height) * stepProgress;
+    if(scrollRectEasedPrev == scrollRectEased) {
+        scrollRectInterpolated = scrollRectEased;
+    }
+    
+    //==========================================================
+    // idle detection.
+    //==========================================================
+    
+    stats.beginPhase(OFX_SCROLL_VIEW_PHASE_MATRIX);
+    ofxScrollViewTransform transformNew = getTransformForRect(scrollRectInterpolated);
+    stats.endPhase(OFX_SCROLL_VIEW_PHASE_MATRIX);
+    bool bChanged = (transformNew != transform);
+    transform = transformNew;
+    if(bChanged == true) {
+        updateRenderOrigin();
+        updateLod();
+    } else {
+        bRenderOriginChanged = false;
+        bLodLevelChanged = false;
+    }
+    
+    bNeedsRedraw = bChanged || bRedrawRequested;
+    bRedrawRequested = false;
+    
+    bool bSettledNew = true;
+    bSettledNew = bSettledNew && (bChanged == false);
+    bSettledNew = bSettledNew && (bAnimating == false);
+    bSettledNew = bSettledNew && (bDragging == false);
+    bSettledNew = bSettledNew && (bZooming == false);
+    bSettledNew = bSettledNew && (dragVel.x == 0) && (dragVel.y == 0);
+    bSettledNew = bSettledNew && (scrollRect == scrollRectEased);
+    bSettledNew = bSettledNew && (scrollRectEasedPrev == scrollRectEased);
+    
+    if(stats.isEnabled() == true) {
+        ofxScrollViewState state = OFX_SCROLL_VIEW_STATE_EASING;
+        if(bAnimating == true) {
+            state = OFX_SCROLL_VIEW_STATE_ANIMATING;
+        } else if(bZooming == true) {
+            state = OFX_SCROLL_VIEW_STATE_ZOOMING;
+        } else if(bDragging == true) {
+            state = OFX_SCROLL_VIEW_STATE_DRAGGING;
+        } else if(bSettledNew == true) {
+            state = OFX_SCROLL_VIEW_STATE_IDLE;
+        }
+        stats.endFrame(state, bSettledNew);
+    }
+    
+    if(bSettled == bSettledNew) {
+        return;
+    }
+    bSettled = bSettledNew;
+    
+    if(bSettled == true) {
+        scrollSettled();
+    } else {
+        scrollMoving();
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setLodThresholds(const std::vector<float> & thresholds) {
+    lodThresholds = thresholds;
+    std::sort(lodThresholds.begin(), lodThresholds.end());
+    updateLod(false);
+}
+
+void ofxScrollViewCore::setLodHysteresis(float value) {
+    lodHysteresis = maxf(value, 0.0);
+}
+
+int ofxScrollViewCore::getLodLevel() {
+    return lodLevel;
+}
+
+int ofxScrollViewCore::getNumOfLodLevels() {
+    return lodThresholds.size() + 1;
+}
+
+float ofxScrollViewCore::getLodZoom() {
+    ofxScrollViewScalar scaleDrawn = transform.scale;
+    if(bLargeWorld == true) {
+        if(scaleMin <= 0 || scaleMax <= scaleMin) {
+            return 0.0;
+        }
+        return clampf(std::log(scaleDrawn / scaleMin) / std::log(scaleMax / scaleMin), 0.0, 1.0);
+    }
+    return scaleToZoom(scaleDrawn);
+}
+
+bool ofxScrollViewCore::hasLodLevelChanged() {
+    return bLodLevelChanged;
+}
+
+void ofxScrollViewCore::updateLod(bool bHysteresis) {
+    float zoom = getLodZoom();
+    float hysteresis = (bHysteresis == true) ? lodHysteresis : 0.0;
+    int numOfThresholds = lodThresholds.size();
+    
+    int level = (bHysteresis == true) ? std::min(lodLevel, numOfThresholds) : 0;
+    while(level < numOfThresholds && zoom >= lodThresholds[level] + hysteresis) {
+        level += 1;
+    }
+    while(level > 0 && zoom < lodThresholds[level - 1] - hysteresis) {
+        level -= 1;
+    }
+    
+    bLodLevelChanged = (level != lodLevel);
+    if(bLodLevelChanged == false) {
+        return;
+    }
+    int levelPrev = lodLevel;
+    lodLevel = level;
+    lodChanged(levelPrev);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setLargeWorld(bool value) {
+    bLargeWorld = value;
+    updateRenderOrigin();
+    setNeedsRedraw();
+}
+
+bool ofxScrollViewCore::isLargeWorld() {
+    return bLargeWorld;
+}
+
+const ofxScrollViewVec2 & ofxScrollViewCore::getRenderOrigin() {
+    return renderOrigin;
+}
+
+const ofxScrollViewTransform & ofxScrollViewCore::getRenderTransform() {
+    return renderTransform;
+}
+
+bool ofxScrollViewCore::hasRenderOriginChanged() {
+    return bRenderOriginChanged;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getRectRelativeToRenderOrigin(const ofxScrollViewRect & rect) {
+    return ofxScrollViewRect(rect.x - renderOrigin.x, rect.y - renderOrigin.y, rect.width, rect.height);
+}
+
+void ofxScrollViewCore::updateRenderOrigin() {
+    
+    //==========================================================
+    // the origin snaps to a power of two grid the size of the visible content,
+    // and only moves once the view is far enough away for float offsets from it to lose sub pixel accuracy.
+    // that's rare, so anything built relative to it stays valid while panning and zooming around.
+    //==========================================================
+    
+    ofxScrollViewVec2 renderOriginNew;
+    
+    if(bLargeWorld == true && transform.scale > 0) {
+        
+        ofxScrollViewRect visibleRect = getVisibleContentRectForRect(scrollRectInterpolated);
+        ofxScrollViewScalar visibleSize = maxf(visibleRect.width, visibleRect.height);
+        ofxScrollViewVec2 visibleCentre(visibleRect.x + visibleRect.width * 0.5,
+                                        visibleRect.y + visibleRect.height * 0.5);
+        
+        ofxScrollViewScalar dx = std::abs(visibleCentre.x - renderOrigin.x);
+        ofxScrollViewScalar dy = std::abs(visibleCentre.y - renderOrigin.y);
+        bool bRebase = (maxf(dx, dy) > visibleSize * 16);
+        
+        renderOriginNew = renderOrigin;
+        if(bRebase == true && visibleSize > 0) {
+            ofxScrollViewScalar gridSize = std::pow((ofxScrollViewScalar)2.0, std::ceil(std::log2(visibleSize)));
+            renderOriginNew.x = std::floor(visibleCentre.x / gridSize) * gridSize;
+            renderOriginNew.y = std::floor(visibleCentre.y / gridSize) * gridSize;
+        }
+    }
+    
+    bRenderOriginChanged = (renderOriginNew != renderOrigin);
+    renderOrigin = renderOriginNew;
+    
+    renderTransform.scale = transform.scale;
+    renderTransform.x = transform.x + renderOrigin.x * transform.scale;
+    renderTransform.y = transform.y + renderOrigin.y * transform.scale;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewCore::isSettled() {
+    return bSettled;
+}
+
+bool ofxScrollViewCore::needsRedraw() {
+    return bNeedsRedraw;
+}
+
+void ofxScrollViewCore::setNeedsRedraw() {
+    bNeedsRedraw = true;
+    bRedrawRequested = true;
+}
+
+//-------------------------------------------------------------- the brains!
+ofxScrollViewRect ofxScrollViewCore::getRectContainedInWindowRect(const ofxScrollViewRect & rectToContain,
+                                                                  float easing) {
+    
+    ofxScrollViewRect rect = rectToContain;
+    
+    ofxScrollViewScalar x0, x1, y0, y1;
+    getPositionRangeForRect(rect, x0, x1, y0, y1);
+    
+    if(rect.x < x0) {
+        rect.x += (x0 - rect.x) * easing;
+        if(std::abs(x0 - rect.x) < kEasingStop) {
+            rect.x = x0;
+        }
+    } else if(rect.x > x1) {
+        rect.x += (x1 - rect.x) * easing;
+        if(std::abs(x1 - rect.x) < kEasingStop) {
+            rect.x = x1;
+        }
+    }
+    
+    if(rect.y < y0) {
+        rect.y += (y0 - rect.y) * easing;
+        if(std::abs(y0 - rect.y) < kEasingStop) {
+            rect.y = y0;
+        }
+    } else if(rect.y > y1) {
+        rect.y += (y1 - rect.y) * easing;
+        if(std::abs(y1 - rect.y) < kEasingStop) {
+            rect.y = y1;
+        }
+    }
+    
+    return rect;
+}
+
+void ofxScrollViewCore::getPositionRangeForRect(const ofxScrollViewRect & rect,
+                                                ofxScrollViewScalar & x0, ofxScrollViewScalar & x1,
+                                                ofxScrollViewScalar & y0, ofxScrollViewScalar & y1) {
+    
+    ofxScrollViewRect boundingRect = windowRect;
+    ofxScrollViewRect contentRectMin = contentRect;
+    contentRectMin.width *= scaleMin;
+    contentRectMin.height *= scaleMin;
+    
+    if(rect.width < windowRect.width) {
+        boundingRect.x = windowRect.x + (windowRect.width - contentRectMin.width) * 0.5;
+        boundingRect.width = contentRectMin.width;
+    }
+    if(rect.height < windowRect.height) {
+        boundingRect.y = windowRect.y + (windowRect.height - contentRectMin.height) * 0.5;
+        boundingRect.height = contentRectMin.height;
+    }
+    
+    x0 = boundingRect.x - maxf(rect.width - boundingRect.width, 0.0);
+    x1 = boundingRect.x;
+    y0 = boundingRect.y - maxf(rect.height - boundingRect.height, 0.0);
+    y1 = boundingRect.y;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getRectZoomedAtScreenPoint(const ofxScrollViewRect & rect,
+                                                                const ofxScrollViewVec2 & screenPoint,
+                                                                ofxScrollViewScalar zoom) {
+    
+    ofxScrollViewScalar zoomScale = zoomToScale(zoom);
+    
+    ofxScrollViewVec2 contentPoint = getContentPointAtScreenPoint(rect, screenPoint);
+    
+    ofxScrollViewVec2 p0(0, 0);
+    ofxScrollViewVec2 p1(contentRect.width, contentRect.height);
+    p0 -= contentPoint;
+    p1 -= contentPoint;
+    p0 *= zoomScale;
+    p1 *= zoomScale;
+    p0 += screenPoint;
+    p1 += screenPoint;
+    
+    ofxScrollViewRect rectNew;
+    rectNew.x = p0.x;
+    rectNew.y = p0.y;
+    rectNew.width = p1.x - p0.x;
+    rectNew.height = p1.y - p0.y;
+    
+    return rectNew;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getRectWithContentPointAtScreenPoint(const ofxScrollViewRect & rect,
+                                                                          const ofxScrollViewVec2 & contentPoint,
+                                                                          const ofxScrollViewVec2 & screenPoint) {
+    
+    ofxScrollViewVec2 contentScreenPoint = getScreenPointAtContentPoint(rect, contentPoint);
+    ofxScrollViewVec2 contentPointToScreenPointDifference = screenPoint - contentScreenPoint;
+    
+    ofxScrollViewRect rectNew;
+    rectNew = scrollRect;
+    rectNew.x += contentPointToScreenPointDifference.x;
+    rectNew.y += contentPointToScreenPointDifference.y;
+    
+    return rectNew;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getRectLerp(const ofxScrollViewRect & rectFrom,
+                                                 const ofxScrollViewRect & rectTo,
+                                                 float progress) {
+    
+    ofxScrollViewScalar x0 = rectFrom.x + (rectTo.x - rectFrom.x) * progress;
+    ofxScrollViewScalar y0 = rectFrom.y + (rectTo.y - rectFrom.y) * progress;
+    ofxScrollViewScalar x1 = (rectFrom.x + rectFrom.width) + ((rectTo.x + rectTo.width) - (rectFrom.x + rectFrom.width)) * progress;
+    ofxScrollViewScalar y1 = (rectFrom.y + rectFrom.height) + ((rectTo.y + rectTo.height) - (rectFrom.y + rectFrom.height)) * progress;
+    
+    ofxScrollViewRect rect;
+    rect.x = minf(x0, x1);
+    rect.y = minf(y0, y1);
+    rect.width = std::abs(x1 - x0);
+    rect.height = std::abs(y1 - y0);
+    
+    return rect;
+}
+
+ofxScrollViewTransform ofxScrollViewCore::getTransformForRect(const ofxScrollViewRect & rect) {
+    
+    ofxScrollViewTransform rectTransform;
+    rectTransform.scale = rect.width / contentRect.width;
+    rectTransform.x = rect.x;
+    rectTransform.y = rect.y;
+    
+    return rectTransform;
+}
+
+ofxScrollViewRect ofxScrollViewCore::getVisibleContentRectForRect(const ofxScrollViewRect & rect,
+                                                                  float margin) {
+    
+    // inverts rect against windowRect to find the part of the content on screen.
+    // margin is in screen pixels and grows the window rect before inverting.
+    
+    ofxScrollViewRect visibleRect;
+    if(rect.width <= 0 || rect.height <= 0) {
+        return visibleRect;
+    }
+    
+    ofxScrollViewScalar rectScaleX = rect.width / contentRect.width;
+    ofxScrollViewScalar rectScaleY = rect.height / contentRect.height;
+    
+    ofxScrollViewScalar x0 = (windowRect.x - margin - rect.x) / rectScaleX;
+    ofxScrollViewScalar x1 = (windowRect.x + windowRect.width + margin - rect.x) / rectScaleX;
+    ofxScrollViewScalar y0 = (windowRect.y - margin - rect.y) / rectScaleY;
+    ofxScrollViewScalar y1 = (windowRect.y + windowRect.height + margin - rect.y) / rectScaleY;
+    
+    x0 = maxf(x0, 0.0);
+    x1 = minf(x1, contentRect.width);
+    y0 = maxf(y0, 0.0);
+    y1 = minf(y1, contentRect.height);
+    
+    if(x1 <= x0 || y1 <= y0) {
+        return visibleRect;
+    }
+    
+    visibleRect.x = x0;
+    visibleRect.y = y0;
+    visibleRect.width = x1 - x0;
+    visibleRect.height = y1 - y0;
+    
+    return visibleRect;
+}
+
+ofxScrollViewVec2 ofxScrollViewCore::getContentPointAtScreenPoint(const ofxScrollViewRect & rect,
+                                                                  const ofxScrollViewVec2 & screenPoint) {
+    
+    ofxScrollViewVec2 contentPoint;
+    contentPoint.x = mapf(screenPoint.x, rect.x, rect.x + rect.width, 0, contentRect.width, true);
+    contentPoint.y = mapf(screenPoint.y, rect.y, rect.y + rect.height, 0, contentRect.height, true);
+    return contentPoint;
+}
+
+ofxScrollViewVec2 ofxScrollViewCore::getScreenPointAtContentPoint(const ofxScrollViewRect & rect,
+                                                                  const ofxScrollViewVec2 & contentPoint) {
+    
+    ofxScrollViewVec2 screenPoint;
+    screenPoint.x = mapf(contentPoint.x, 0, contentRect.width, rect.x, rect.x + rect.width, true);
+    screenPoint.y = mapf(contentPoint.y, 0, contentRect.height, rect.y, rect.y + rect.height, true);
+    return screenPoint;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::getScreenPointsAtContentPoints(const float * contentPoints, float * screenPoints, int numOfPoints) {
+    ofxScrollViewTransformBatch::transformPoints(transform, contentPoints, screenPoints, numOfPoints);
+}
+
+void ofxScrollViewCore::getContentPointsAtScreenPoints(const float * screenPoints, float * contentPoints, int numOfPoints) {
+    ofxScrollViewTransformBatch::transformPointsInverse(transform, screenPoints, contentPoints, numOfPoints);
+}
+
+void ofxScrollViewCore::getScreenRectsAtContentRects(const float * contentRects, float * screenRects, int numOfRects) {
+    ofxScrollViewTransformBatch::transformRects(transform, contentRects, screenRects, numOfRects);
+}
+
+void ofxScrollViewCore::getContentRectsAtScreenRects(const float * screenRects, float * contentRects, int numOfRects) {
+    ofxScrollViewTransformBatch::transformRectsInverse(transform, screenRects, contentRects, numOfRects);
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewCore::getInputVelocityPerStep(double timeNow, ofxScrollViewVec2 & velocity) {
+    float timeStep = (timeStepInSec > 0) ? timeStepInSec : timeDelta; // without fixed steps, one update.
+    if(timeStep <= 0) {
+        return false;
+    }
+    if(inputQueue.getVelocity(timeNow, inputVelocityWindowInSec, velocity) == false) {
+        return false;
+    }
+    velocity *= timeStep;
+    return true;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::addContentItem(int itemID, const ofxScrollViewRect & rect) {
+    contentIndex.insert(itemID, rect);
+}
+
+void ofxScrollViewCore::moveContentItem(int itemID, const ofxScrollViewRect & rect) {
+    contentIndex.move(itemID, rect);
+}
+
+void ofxScrollViewCore::removeContentItem(int itemID) {
+    contentIndex.remove(itemID);
+}
+
+void ofxScrollViewCore::clearContentItems() {
+    contentIndex.clear();
+}
+
+void ofxScrollViewCore::getVisibleContentItems(std::vector<int> & itemIDs) {
+    itemIDs.clear();
+    
+    ofxScrollViewRect visibleRect = getVisibleContentRect();
+    if(visibleRect.isEmpty() == true) {
+        return;
+    }
+    contentIndex.getItemsInRect(visibleRect, itemIDs);
+}
+
+int ofxScrollViewCore::getContentItemAtScreenPoint(const ofxScrollViewVec2 & screenPoint) {
+    if(windowRect.inside(screenPoint.x, screenPoint.y) == false) {
+        return -1;
+    }
+    ofxScrollViewVec2 contentPoint = getContentPointAtScreenPoint(scrollRectInterpolated, screenPoint);
+    return contentIndex.getItemAtPoint(contentPoint.x, contentPoint.y);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::invalidateContentRect(const ofxScrollViewRect & rect) {
+    ofxScrollViewRect dirtyRect = getRectIntersection(rect, ofxScrollViewRect(0, 0, contentRect.width, contentRect.height));
+    if(dirtyRect.isEmpty() == true) {
+        return;
+    }
+    
+    setNeedsRedraw();
+    
+    // overlapping rects are merged so no area is drawn twice.
+    for(int i=0; i<dirtyContentRects.size(); i++) {
+        if(ofxScrollViewContentIndex::intersects(dirtyContentRects[i], dirtyRect) == false) {
+            continue;
+        }
+        dirtyRect = getRectUnion(dirtyContentRects[i], dirtyRect);
+        dirtyContentRects[i] = dirtyContentRects.back();
+        dirtyContentRects.pop_back();
+        i = -1; // the bigger rect may now touch ones already checked.
+    }
+    dirtyContentRects.push_back(dirtyRect);
+    
+    if(dirtyContentRects.size() > kDirtyContentRectsMax) {
+        for(int i=1; i<dirtyContentRects.size(); i++) {
+            dirtyContentRects[0] = getRectUnion(dirtyContentRects[0], dirtyContentRects[i]);
+        }
+        dirtyContentRects.resize(1);
+    }
+}
+
+bool ofxScrollViewCore::hasDirtyContentRects() {
+    return dirtyContentRects.size() > 0;
+}
+
+const std::vector<ofxScrollViewRect> & ofxScrollViewCore::getDirtyContentRects() {
+    return dirtyContentRects;
+}
+
+void ofxScrollViewCore::getVisibleDirtyContentRects(std::vector<ofxScrollViewRect> & rects) {
+    rects.clear();
+    
+    ofxScrollViewRect visibleRect = getVisibleContentRect();
+    for(int i=0; i<dirtyContentRects.size(); i++) {
+        ofxScrollViewRect rect = getRectIntersection(dirtyContentRects[i], visibleRect);
+        if(rect.isEmpty() == false) {
+            rects.push_back(rect);
+        }
+    }
+}
+
+void ofxScrollViewCore::clearDirtyContentRects() {
+    dirtyContentRects.clear();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::setInputSources(int numOfSources, int capacity) {
+    if(numOfSources > kInputSourcesMax) {
+        numOfSources = kInputSourcesMax;
+    }
+    inputSources.clear();
+    for(int i=0; i<numOfSources; i++) {
+        inputSources.push_back(std::make_shared<ofxScrollViewRingBuffer<ofxScrollViewInputEvent> >(capacity));
+    }
+}
+
+bool ofxScrollViewCore::postTouchDown(int x, int y, int id, int source, double timeInSec) {
+    ofxScrollViewInputEvent event = {};
+    event.timeInSec = timeInSec;
+    event.x = x;
+    event.y = y;
+    event.touchID = id;
+    event.type = OFX_SCROLL_VIEW_INPUT_TOUCH_DOWN;
+    return postInputEvent(event, source);
+}
+
+bool ofxScrollViewCore::postTouchMoved(int x, int y, int id, int source, double timeInSec) {
+    ofxScrollViewInputEvent event = {};
+    event.timeInSec = timeInSec;
+    event.x = x;
+    event.y = y;
+    event.touchID = id;
+    event.type = OFX_SCROLL_VIEW_INPUT_TOUCH_MOVED;
+    return postInputEvent(event, source);
+}
+
+bool ofxScrollViewCore::postTouchUp(int x, int y, int id, int source, double timeInSec) {
+    ofxScrollViewInputEvent event = {};
+    event.timeInSec = timeInSec;
+    event.x = x;
+    event.y = y;
+    event.touchID = id;
+    event.type = OFX_SCROLL_VIEW_INPUT_TOUCH_UP;
+    return postInputEvent(event, source);
+}
+
+bool ofxScrollViewCore::postTouchCancelled(int x, int y, int id, int source, double timeInSec) {
+    ofxScrollViewInputEvent event = {};
+    event.timeInSec = timeInSec;
+    event.x = x;
+    event.y = y;
+    event.touchID = id;
+    event.type = OFX_SCROLL_VIEW_INPUT_TOUCH_CANCELLED;
+    return postInputEvent(event, source);
+}
+
+bool ofxScrollViewCore::postInputEvent(const ofxScrollViewInputEvent & event, int source) {
+    if(source < 0 || source >= inputSources.size()) {
+        return false;
+    }
+    return inputSources[source]->push(event);
+}
+
+void ofxScrollViewCore::updateInputSources() {
+    
+    //==========================================================
+    // merge the sources by time, each one is already in order.
+    // only what was posted before draining started is taken,
+    // so a busy producer can't keep update() here forever.
+    //==========================================================
+    
+    int numOfSources = inputSources.size();
+    int numOfEvents[kInputSourcesMax];
+    int numOfEventsTotal = 0;
+    for(int i=0; i<numOfSources; i++) {
+        numOfEvents[i] = inputSources[i]->size();
+        numOfEventsTotal += numOfEvents[i];
+    }
+    if(numOfEventsTotal == 0) {
+        return;
+    }
+    
+    // events posted without a time are stamped here, on the update thread, with the one clock read.
+    double timeDrain = getTimeInSec();
+    
+    ofxScrollViewInputEvent event = {};
+    while(numOfEventsTotal > 0) {
+        
+        int sourceNext = -1;
+        double timeNext = 0;
+        for(int i=0; i<numOfSources; i++) {
+            if(numOfEvents[i] == 0) {
+                continue;
+            }
+            inputSources[i]->peek(event);
+            double time = (event.timeInSec < 0) ? timeDrain : event.timeInSec;
+            if(sourceNext == -1 || time < timeNext) {
+                sourceNext = i;
+                timeNext = time;
+            }
+        }
+        
+        inputSources[sourceNext]->pop(event);
+        numOfEvents[sourceNext] -= 1;
+        numOfEventsTotal -= 1;
+        if(event.timeInSec < 0) {
+            event.timeInSec = timeDrain;
+        }
+        
+        inputEventTimeInSec = event.timeInSec;
+        if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_DOWN) {
+            touchDown(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_MOVED) {
+            touchMoved(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_UP) {
+            touchUp(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_DOUBLE_TAP) {
+            touchDoubleTap(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_CANCELLED) {
+            touchCancelled(event.x, event.y, event.touchID);
+        }
+        inputEventTimeInSec = -1;
+    }
+}
+
+double ofxScrollViewCore::getInputTimeInSec() {
+    if(inputEventTimeInSec >= 0) {
+        return inputEventTimeInSec;
+    }
+    return getTimeInSec();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::dragDown(const ofxScrollViewVec2 & point) {
+    dragDownPos = dragMovePos = dragMovePosPrev = point;
+    dragVel.set(0);
+    
+    inputQueue.clear();
+    inputQueue.add(point, getInputTimeInSec());
+    
+    bDragging = true;
+    bAnimating = false;
+}
+
+void ofxScrollViewCore::dragMoved(const ofxScrollViewVec2 & point) {
+    dragMovePos = point;
+    inputQueue.add(point, getInputTimeInSec());
+}
+
+void ofxScrollViewCore::dragUp(const ofxScrollViewVec2 & point) {
+    dragMovePos = point;
+    
+    // fling with the velocity right up to letting go, not the one from the last update.
+    double timeNow = getInputTimeInSec();
+    inputQueue.add(point, timeNow);
+    ofxScrollViewVec2 inputVel;
+    if(bDragging == true && getInputVelocityPerStep(timeNow, inputVel) == true) {
+        dragVel = inputVel;
+    }
+    
+    bDragging = false;
+}
+
+void ofxScrollViewCore::dragCancel() {
+    dragVel.set(0);
+    
+    bDragging = false;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::zoomDown(const ofxScrollViewVec2 & point, float pointDist) {
+    if(bPinchZoomEnabled == false) {
+        return;
+    }
+    
+    zoomDownPos = zoomMovePos = zoomMovePosPrev = point;
+    zoomDownDist = zoomMoveDist = pointDist;
+    
+    inputQueue.clear();
+    inputQueue.add(point, getInputTimeInSec());
+    
+    scaleDown = scale;
+    
+    bZooming = true;
+    bAnimating = false;
+}
+
+void ofxScrollViewCore::zoomMoved(const ofxScrollViewVec2 & point, float pointDist) {
+    if(bPinchZoomEnabled == false) {
+        return;
+    }
+    
+    zoomMovePos = point;
+    zoomMoveDist = pointDist;
+    inputQueue.add(point, getInputTimeInSec());
+}
+
+void ofxScrollViewCore::zoomUp(const ofxScrollViewVec2 & point, float pointDist) {
+    if(bPinchZoomEnabled == false) {
+        return;
+    }
+    
+    zoomMovePos = point;
+    zoomMoveDist = pointDist;
+    
+    double timeNow = getInputTimeInSec();
+    inputQueue.add(point, timeNow);
+    ofxScrollViewVec2 inputVel;
+    if(bZooming == true && getInputVelocityPerStep(timeNow, inputVel) == true) {
+        dragVel = inputVel;
+    }
+    
+    bZooming = false;
+}
+
+void ofxScrollViewCore::zoomCancel() {
+    bZooming = false;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::scrollSettled() {
+    //
+}
+
+void ofxScrollViewCore::scrollMoving() {
+    //
+}
+
+void ofxScrollViewCore::lodChanged(int) {
+    //
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::mouseMoved(int, int) {
+    //
+}
+
+void ofxScrollViewCore::mousePressed(int x, int y, int button) {
+    if(button == 0) {
+        
+        touchDown(x, y, 0);
+        
+    } else if(button == 2) {
+        
+        touchDown(x, y, 0);
+        touchDown(x, y, 2);
+    }
+}
+
+void ofxScrollViewCore::mouseDragged(int x, int y, int button) {
+    touchMoved(x, y, button);
+}
+
+void ofxScrollViewCore::mouseReleased(int x, int y, int button) {
+    touchUp(x, y, button);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCore::touchDown(int x, int y, int id) {
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_TOUCH_DOWN, getInputTimeInSec(), x, y, id);
+    }
+    
+    bool bHit = windowRect.inside(x, y);
+    if(bHit == false) {
+        return;
+    }
+    
+    ofxScrollViewTouchPoint touchPointNew;
+    touchPointNew.touchPos.set(x, y);
+    touchPointNew.touchID = id;
+    touchPointNew.touchDownTimeInSec = getInputTimeInSec();
+    
+    //---------------------------------------------------------- double tap.
+    ofxScrollViewVec2 touchPointDiff = touchPointNew.touchPos - touchDownPointLast.touchPos;
+    float touchTimeDiff = touchPointNew.touchDownTimeInSec - touchDownPointLast.touchDownTimeInSec;
+    
+    touchDownPointLast = touchPointNew;
+    
+    bool bDoubleTap = true;
+    bDoubleTap = bDoubleTap && (touchTimeDiff < doubleTapRegistrationTimeInSec);
+    bDoubleTap = bDoubleTap && (touchPointDiff.length() < doubleTapRegistrationDistanceInPixels);
+    
+    if(bDoubleTapZoomEnabled == true &&
+       bDoubleTap == true) {
+        
+        dragCancel();
+        zoomCancel();
+        
+        touchPoints.clear();
+        touchDownPointLast.touchPos.set(0, 0);
+        touchDownPointLast.touchDownTimeInSec = 0.0;
+        
+        // replaying this touch down taps again, so the double tap isn't recorded on its own.
+        ofxScrollViewInputRecorder * recorder = inputRecorder;
+        inputRecorder = NULL;
+        touchDoubleTap(x, y, id);
+        inputRecorder = recorder;
+        return;
+    }
+    
+    //----------------------------------------------------------
+    if(touchPoints.add(touchPointNew) == false) {
+        return; // max 2 touches.
+    }
+    
+    if(touchPoints.size() == 1) {
+        
+        zoomCancel();
+        dragDown(touchPoints[0].touchPos);
+        
+    } else if(touchPoints.size() == 2) {
+        
+        ofxScrollViewVec2 tp0(touchPoints[0].touchPos);
+        ofxScrollViewVec2 tp1(touchPoints[1].touchPos);
+        ofxScrollViewVec2 tmp = (tp1 - tp0) * 0.5 + tp0;
+        float dist = (tp1 - tp0).length();
+        
+        dragCancel();
+        zoomDown(tmp, dist);
+    }
+}
+
+void ofxScrollViewCore::touchMoved(int x, int y, int id) {
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_TOUCH_MOVED, getInputTimeInSec(), x, y, id);
+    }
+    
+    int touchIndex = touchPoints.find(id);
+    if(touchIndex == -1) {
+        return;
+    }
+    touchPoints[touchIndex].touchPos.set(x, y);
+    
+    if(touchPoints.size() == 1) {
+        
+        dragMoved(touchPoints[0].touchPos);
+        
+    } else if(touchPoints.size() == 2) {
+        
+        ofxScrollViewVec2 tp0(touchPoints[0].touchPos);
+        ofxScrollViewVec2 tp1(touchPoints[1].touchPos);
+        ofxScrollViewVec2 tmp = (tp1 - tp0) * 0.5 + tp0;
+        float dist = (tp1 - tp0).length();
+        
+        zoomMoved(tmp, dist);
+    }
+}
+
+void ofxScrollViewCore::touchUp(int x, int y, int id) {
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_TOUCH_UP, getInputTimeInSec(), x, y, id);
+    }
+    
+    int touchIndex = touchPoints.find(id);
+    if(touchIndex == -1) {
+        return;
+    }
+    touchPoints[touchIndex].touchPos.set(x, y);
+    
+    if(touchPoints.size() == 1) {
+        
+        dragUp(touchPoints[0].touchPos);
+        
+    } else if(touchPoints.size() == 2) {
+        
+        ofxScrollViewVec2 tp0(touchPoints[0].touchPos);
+        ofxScrollViewVec2 tp1(touchPoints[1].touchPos);
+        ofxScrollViewVec2 tmp = (tp1 - tp0) * 0.5 + tp0;
+        float dist = (tp1 - tp0).length();
+        
+        zoomUp(tmp, dist);
+    }
+    
+    touchPoints.clear();
+}
+
+void ofxScrollViewCore::touchDoubleTap(int x, int y, int id) {
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_TOUCH_DOUBLE_TAP, getInputTimeInSec(), x, y, id);
+    }
+    
+    if(bDoubleTapZoomEnabled == false) {
+        return;
+    }
+    
+    bool bHit = windowRect.inside(x, y);
+    if(bHit == false) {
+        return;
+    }
+    
+    ofxScrollViewVec2 touchPoint(x, y);
+    
+    ofxScrollViewScalar zoomCurrent = getZoom();
+    ofxScrollViewScalar zoomTarget = 0.0;
+    
+    bool bZoomedInMax = (zoomCurrent == doubleTapZoomRangeMax);
+    if(bZoomedInMax == true) {
+        zoomTarget = doubleTapZoomRangeMin; // zoom all the way out.
+    } else {
+        zoomTarget = zoomCurrent + doubleTapZoomIncrement;
+    }
+    zoomTarget = clampf(zoomTarget, doubleTapZoomRangeMin, doubleTapZoomRangeMax);
+    
+    float zoomTimeSec = std::abs(zoomTarget - zoomCurrent);
+    zoomTimeSec *= doubleTapZoomIncrementTimeInSec;
+    
+    zoomTo(touchPoint, zoomTarget, zoomTimeSec);
+}
+
+void ofxScrollViewCore::touchCancelled(int x, int y, int id) {
+    if(inputRecorder != NULL) {
+        inputRecorder->record(OFX_SCROLL_VIEW_INPUT_TOUCH_CANCELLED, getInputTimeInSec(), x, y, id);
+    }
+}
@@ -0,0 +1,397 @@
+//
+//  ofxScrollViewCore.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  the scroll and zoom brains of ofxScrollView without any openFrameworks dependency,
+//  so it can be built, benchmarked and driven without a GL context.
+//  time comes from an injectable clock, see setClock().
+//
+
+#pragma once
+
+#include "ofxScrollViewTypes.h"
+#include "ofxScrollViewContentIndex.h"
+#include "ofxScrollViewStats.h"
+#include "ofxScrollViewInputQueue.h"
+#include "ofxScrollViewTransformBatch.h"
+#include "ofxScrollViewRingBuffer.h"
+#include <vector>
+#include <functional>
+#include <memory>
+
+//--------------------------------------------------------------
+class ofxScrollViewTouchPoint {
+public:
+    ofxScrollViewTouchPoint() {
+        touchID = 0;
+        touchDownTimeInSec = 0;
+    }
+    int touchID;
+    ofxScrollViewVec2 touchPos;
+    double touchDownTimeInSec;
+};
+
+//--------------------------------------------------------------
+// the touches a view is following, in the order they went down.
+// fixed size and looked up by id, so touch events never allocate.
+//--------------------------------------------------------------
+class ofxScrollViewTouchTable {
+public:
+    static int const kCapacity = 2; // one finger drags, two pinch.
+    
+    ofxScrollViewTouchTable() {
+        numOfTouches = 0;
+    }
+    int size() const {
+        return numOfTouches;
+    }
+    bool isFull() const {
+        return numOfTouches == kCapacity;
+    }
+    void clear() {
+        numOfTouches = 0;
+    }
+    bool add(const ofxScrollViewTouchPoint & touch) {
+        if(numOfTouches == kCapacity) {
+            return false;
+        }
+        touches[numOfTouches++] = touch;
+        return true;
+    }
+    int find(int touchID) const {   // -1 when it isn't being followed.
+        for(int i=0; i<numOfTouches; i++) {
+            if(touches[i].touchID == touchID) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    ofxScrollViewTouchPoint & operator [] (int index) {
+        return touches[index];
+    }
+    
+private:
+    ofxScrollViewTouchPoint touches[kCapacity];
+    int numOfTouches;
+};
+
+//--------------------------------------------------------------
+enum ofxScrollViewAspectRatioMode {
+    OFX_SCROLL_VIEW_ASPECT_RATIO_IGNORE = 0,
+    OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP,
+    OFX_SCROLL_VIEW_ASPECT_RATIO_KEEP_BY_EXPANDING
+};
+
+typedef std::function<double()> ofxScrollViewClock;  // seconds, double so it holds up after hours of uptime.
+
+class ofxScrollViewInputRecorder;
+
+//--------------------------------------------------------------
+class ofxScrollViewCore {
+    
+public:
+    
+    ofxScrollViewCore();
+    virtual ~ofxScrollViewCore();
+    
+    void setClock(const ofxScrollViewClock & clock);
+    double getTimeInSec();
+    
+    void setInputRecorder(ofxScrollViewInputRecorder * recorder); // records touch input and update() times, NULL to stop.
+    ofxScrollViewStats & getStats(); // phase timings and state counters, getStats().setEnabled(true) to collect.
+    
+    void setPinchZoom(bool bEnable);
+    void setPinchZoomSupported(bool bSupported);
+    void setScrollEasing(float value);
+    void setBounceBack(float value);
+    void setDragVelocityDecay(float value);
+    void setDoubleTapZoom(bool bEnable);
+    void setDoubleTapZoomRangeMin(ofxScrollViewScalar value);
+    void setDoubleTapZoomRangeMax(ofxScrollViewScalar value);
+    void setDoubleTapZoomIncrement(ofxScrollViewScalar value);
+    void setDoubleTapZoomIncrementTimeInSec(float value);
+    void setDoubleTapRegistrationTimeInSec(float value);
+    void setDoubleTapRegistrationDistanceInPixels(float value);
+    void setVisibleContentMargin(float value);
+    void setTimeStep(float timeStepInSec);      // fixed physics step, 0 steps once per update() like before.
+    void setMaxStepsPerUpdate(int value);       // bounds the catch up after a long frame.
+    void setInputVelocityWindow(float timeInSec);   // how far back drag samples count towards the fling velocity, default 0.1.
+    void setInputPrediction(float timeInSec);       // draws a drag this far ahead of the last touch, default 0 is off.
+    
+    virtual void setup();
+    virtual void reset();
+    
+    void setWindowRect(const ofxScrollViewRect & rect);
+    void setContentRect(const ofxScrollViewRect & rect);
+    
+    void fitContentToWindow(ofxScrollViewAspectRatioMode aspectRatioMode);
+    
+    void setScale(ofxScrollViewScalar value);
+    void setScaleMin(ofxScrollViewScalar value);
+    void setScaleMax(ofxScrollViewScalar value);
+    
+    ofxScrollViewScalar getScale();
+    ofxScrollViewScalar getScaleMin();
+    ofxScrollViewScalar getScaleMax();
+    
+    void setZoom(ofxScrollViewScalar value);
+    ofxScrollViewScalar getZoom();
+    bool isZoomed();
+    bool isZoomedInMax();
+    bool isZoomedOutMax();
+    
+    ofxScrollViewScalar zoomToScale(ofxScrollViewScalar value);
+    ofxScrollViewScalar scaleToZoom(ofxScrollViewScalar value);
+    
+    void zoomToMin(const ofxScrollViewVec2 & screenPoint, float timeSec=0.0);
+    void zoomToMax(const ofxScrollViewVec2 & screenPoint, float timeSec=0.0);
+    void zoomTo(const ofxScrollViewVec2 & screenPoint, ofxScrollViewScalar zoom, float timeSec=0.0);
+    void zoomToContentPointAndPositionAtScreenPoint(const ofxScrollViewVec2 & contentPoint,
+                                                    const ofxScrollViewVec2 & screenPoint,
+                                                    ofxScrollViewScalar zoom,
+                                                    float timeSec=0.0);
+    void moveContentPointToScreenPoint(const ofxScrollViewVec2 & contentPoint,
+                                       const ofxScrollViewVec2 & screenPoint,
+                                       float timeSec=0.0);
+    bool animStart(float animTimeInSec);
+    
+    void setScrollPositionX(ofxScrollViewScalar x, bool bEase=true);
+    void setScrollPositionY(ofxScrollViewScalar y, bool bEase=true);
+    void setScrollPosition(ofxScrollViewScalar x, ofxScrollViewScalar y, bool bEase=true);
+    
+    ofxScrollViewVec2 getScrollPosition();
+    ofxScrollViewVec2 getScrollPositionNorm();
+    
+    const ofxScrollViewRect & getWindowRect();
+    const ofxScrollViewRect & getContentRect();
+    const ofxScrollViewRect & getScrollRect();
+    const ofxScrollViewTransform & getTransform();
+    ofxScrollViewRect getVisibleContentRect();
+    ofxScrollViewRect getPredictedScrollRect(int numOfFrames);
+    ofxScrollViewRect getPredictedVisibleContentRect(int numOfFrames);
+    ofxScrollViewInputQueue & getInputQueue();  // drag or pinch centre samples since the touch went down.
+    ofxScrollViewVec2 getInputVelocity();       // pixels per second at the last update, fitted over the velocity window.
+    
+    virtual void update();
+    
+    // update() in its phases, for code that needs to run between them.
+    void updateTime();              // works out numOfSteps and stepProgress from the clock.
+    void updateInput();             // animation, drag and pinch, once per update.
+    void updateStep();              // fling, bounce back and easing, once per fixed step.
+    virtual void updateEnd();       // interpolation and idle detection.
+    
+    //-------------------------------------------------------------- large worlds.
+    // for content far past what a float can place to the pixel, build with OFX_SCROLL_VIEW_DOUBLE as well.
+    // the render origin is a content point kept near the viewport, rebased as the view travels.
+    // content is drawn relative to it, so the matrix and the vertices only ever hold small floats.
+    // pinch zoom scales by the ratio of the finger distances so it feels the same at any magnitude.
+    void setLargeWorld(bool bEnable);
+    bool isLargeWorld();
+    const ofxScrollViewVec2 & getRenderOrigin();            // (0, 0) when large world is off.
+    const ofxScrollViewTransform & getRenderTransform();    // getTransform() with the render origin taken out.
+    bool hasRenderOriginChanged();                          // in the last update, anything built relative to it needs rebuilding.
+    ofxScrollViewRect getRectRelativeToRenderOrigin(const ofxScrollViewRect & rect);
+    void updateRenderOrigin();
+    
+    //-------------------------------------------------------------- level of detail.
+    // a discrete level picked from the drawn scale, 0 zoomed all the way out and one higher for each threshold passed.
+    // thresholds are zoom values, 0 at scaleMin and 1 at scaleMax, measured on a log scale in a large world.
+    // a level only changes once the zoom is hysteresis past a threshold, so content doesn't flicker between two.
+    void setLodThresholds(const std::vector<float> & thresholds);  // ascending, default 0.25, 0.5, 0.75.
+    void setLodHysteresis(float value);                             // in zoom, default 0.02.
+    int getLodLevel();
+    int getNumOfLodLevels();
+    float getLodZoom();             // the zoom the level is picked from.
+    bool hasLodLevelChanged();      // in the last update.
+    void updateLod(bool bHysteresis=true);
+    
+    //-------------------------------------------------------------- idle detection.
+    bool isSettled();       // nothing is moving, touching or animating and the view didn't change last update.
+    bool needsRedraw();     // the view changed last update, or setNeedsRedraw() was called since.
+    void setNeedsRedraw();  // for when the content itself changes.
+    
+    //-------------------------------------------------------------- the brains!
+    ofxScrollViewRect getRectContainedInWindowRect(const ofxScrollViewRect & rect,
+                                                   float easing=1.0);
+    
+    void getPositionRangeForRect(const ofxScrollViewRect & rect,  // where rect.x / rect.y can sit without leaving the window.
+                                 ofxScrollViewScalar & x0, ofxScrollViewScalar & x1,
+                                 ofxScrollViewScalar & y0, ofxScrollViewScalar & y1);
+    
+    ofxScrollViewRect getRectZoomedAtScreenPoint(const ofxScrollViewRect & rect,
+                                                 const ofxScrollViewVec2 & screenPoint,
+                                                 ofxScrollViewScalar zoom=0.0);
+    
+    ofxScrollViewRect getRectWithContentPointAtScreenPoint(const ofxScrollViewRect & rect,
+                                                           const ofxScrollViewVec2 & contentPoint,
+                                                           const ofxScrollViewVec2 & screenPoint);
+    
+    ofxScrollViewRect getRectLerp(const ofxScrollViewRect & rectFrom,
+                                  const ofxScrollViewRect & rectTo,
+                                  float progress);
+    
+    ofxScrollViewTransform getTransformForRect(const ofxScrollViewRect & rect);
+    
+    ofxScrollViewRect getVisibleContentRectForRect(const ofxScrollViewRect & rect,
+                                                   float margin=0.0);
+    
+    ofxScrollViewVec2 getContentPointAtScreenPoint(const ofxScrollViewRect & rect,
+                                                   const ofxScrollViewVec2 & screenPoint);
+    
+    ofxScrollViewVec2 getScreenPointAtContentPoint(const ofxScrollViewRect & rect,
+                                                   const ofxScrollViewVec2 & contentPoint);
+    
+    bool getInputVelocityPerStep(double timeNow, ofxScrollViewVec2 & velocity);  // in dragVel units, false without enough samples.
+    
+    //-------------------------------------------------------------- batch transforms with getTransform(), see ofxScrollViewTransformBatch.
+    // points are packed x, y floats and rects x, y, width, height. not clamped to the content. src and dst can be the same.
+    // in a large world pass points relative to getRenderOrigin() through ofxScrollViewTransformBatch with getRenderTransform().
+    void getScreenPointsAtContentPoints(const float * contentPoints, float * screenPoints, int numOfPoints);
+    void getContentPointsAtScreenPoints(const float * screenPoints, float * contentPoints, int numOfPoints);
+    void getScreenRectsAtContentRects(const float * contentRects, float * screenRects, int numOfRects);
+    void getContentRectsAtScreenRects(const float * screenRects, float * contentRects, int numOfRects);
+    
+    //-------------------------------------------------------------- content items, rects in content coordinates.
+    void addContentItem(int itemID, const ofxScrollViewRect & rect);
+    void moveContentItem(int itemID, const ofxScrollViewRect & rect);
+    void removeContentItem(int itemID);
+    void clearContentItems();
+    void getVisibleContentItems(std::vector<int> & itemIDs);
+    int getContentItemAtScreenPoint(const ofxScrollViewVec2 & screenPoint);  // -1 when there's nothing there.
+    
+    //-------------------------------------------------------------- dirty regions, rects in content coordinates.
+    void invalidateContentRect(const ofxScrollViewRect & rect);  // the content inside rect changed, also requests a redraw.
+    bool hasDirtyContentRects();
+    const std::vector<ofxScrollViewRect> & getDirtyContentRects();
+    void getVisibleDirtyContentRects(std::vector<ofxScrollViewRect> & rects);  // clipped to the visible content rect.
+    void clearDirtyContentRects();  // call once the dirty rects are drawn.
+    
+    //-------------------------------------------------------------- input from other threads.
+    // each source is a lock free ring with one producer thread, drained in order by update().
+    // events keep the time they were posted at, so drag velocity doesn't depend on when update() runs.
+    // the view clock isn't thread safe, so it's never read on a posting thread. pass timeInSec from a clock
+    // that is, in the same seconds as the view clock, or leave it at -1 to stamp the event when update() drains it.
+    // posting returns false when the ring is full, nothing is dropped or reordered behind the caller's back.
+    void setInputSources(int numOfSources, int capacity=256);  // one per thread that posts, default 1, max 8. not thread safe.
+    bool postTouchDown(int x, int y, int id, int source=0, double timeInSec=-1);  // -1 stamps it when drained.
+    bool postTouchMoved(int x, int y, int id, int source=0, double timeInSec=-1);
+    bool postTouchUp(int x, int y, int id, int source=0, double timeInSec=-1);
+    bool postTouchCancelled(int x, int y, int id, int source=0, double timeInSec=-1);
+    bool postInputEvent(const ofxScrollViewInputEvent & event, int source=0);
+    void updateInputSources();      // called by updateTime(), feeds the posted events to the touch entry points.
+    double getInputTimeInSec();     // time of the event being handled, the clock outside of updateInputSources().
+    
+    //--------------------------------------------------------------
+    virtual void dragDown(const ofxScrollViewVec2 & point);
+    virtual void dragMoved(const ofxScrollViewVec2 & point);
+    virtual void dragUp(const ofxScrollViewVec2 & point);
+    virtual void dragCancel();
+    
+    virtual void zoomDown(const ofxScrollViewVec2 & point, float pointDist);
+    virtual void zoomMoved(const ofxScrollViewVec2 & point, float pointDist);
+    virtual void zoomUp(const ofxScrollViewVec2 & point, float pointDist);
+    virtual void zoomCancel();
+    
+    virtual void scrollSettled();   // called once when the view comes to rest.
+    virtual void scrollMoving();    // called once when the view starts moving again.
+    virtual void lodChanged(int lodLevelPrev);  // called when getLodLevel() changes.
+    
+    virtual void mouseMoved(int x, int y);
+    virtual void mouseDragged(int x, int y, int button);
+    virtual void mousePressed(int x, int y, int button);
+    virtual void mouseReleased(int x, int y, int button);
+    
+    virtual void touchDown(int x, int y, int id);
+    virtual void touchMoved(int x, int y, int id);
+    virtual void touchUp(int x, int y, int id);
+    virtual void touchDoubleTap(int x, int y, int id);
+    virtual void touchCancelled(int x, int y, int id);
+    
+    //--------------------------------------------------------------
+    ofxScrollViewClock clock;
+    ofxScrollViewInputRecorder * inputRecorder;
+    std::vector<std::shared_ptr<ofxScrollViewRingBuffer<ofxScrollViewInputEvent> > > inputSources;
+    double inputEventTimeInSec; // -1 when not handling a posted event.
+    ofxScrollViewStats stats;
+    
+    ofxScrollViewRect windowRect;
+    ofxScrollViewRect contentRect;
+    
+    bool bPinchZoomEnabled;
+    bool bPinchZoomSupported;
+    
+    ofxScrollViewRect scrollRect;
+    ofxScrollViewRect scrollRectEased;
+    ofxScrollViewRect scrollRectEasedPrev;
+    ofxScrollViewRect scrollRectInterpolated;   // drawn rect, between the last two steps.
+    ofxScrollViewRect scrollRectAnim0;
+    ofxScrollViewRect scrollRectAnim1;
+    float scrollEasing;
+    float bounceBack;
+    float visibleContentMargin;
+    
+    ofxScrollViewVec2 dragDownPos;
+    ofxScrollViewVec2 dragMovePos;
+    ofxScrollViewVec2 dragMovePosPrev;
+    ofxScrollViewVec2 dragVel;
+    float dragVelDecay;
+    bool bDragging;
+    
+    ofxScrollViewInputQueue inputQueue;
+    float inputVelocityWindowInSec;
+    float inputPredictionInSec;
+    
+    ofxScrollViewVec2 zoomDownPos;
+    ofxScrollViewVec2 zoomMovePos;
+    ofxScrollViewVec2 zoomMovePosPrev;
+    float zoomDownDist;
+    float zoomMoveDist;
+    bool bZooming;
+    
+    float timeStepInSec;
+    int maxStepsPerUpdate;
+    double timeLast;
+    float timeDelta;
+    double timeAccumulated;
+    int numOfSteps;
+    float stepProgress;
+    
+    double animTimeStart;
+    float animTimeTotal;
+    bool bAnimating;
+    
+    bool bDoubleTapZoomEnabled;
+    ofxScrollViewScalar doubleTapZoomRangeMin;
+    ofxScrollViewScalar doubleTapZoomRangeMax;
+    ofxScrollViewScalar doubleTapZoomIncrement;
+    float doubleTapZoomIncrementTimeInSec;
+    float doubleTapRegistrationTimeInSec;
+    float doubleTapRegistrationDistanceInPixels;
+    
+    ofxScrollViewScalar scale;
+    ofxScrollViewScalar scaleDown;
+    ofxScrollViewScalar scaleMin;
+    ofxScrollViewScalar scaleMax;
+    ofxScrollViewTransform transform;
+    
+    bool bLargeWorld;
+    bool bRenderOriginChanged;
+    ofxScrollViewVec2 renderOrigin;
+    ofxScrollViewTransform renderTransform;
+    
+    std::vector<float> lodThresholds;
+    float lodHysteresis;
+    int lodLevel;
+    bool bLodLevelChanged;
+    
+    bool bSettled;
+    bool bNeedsRedraw;
+    bool bRedrawRequested;
+    
+    ofxScrollViewContentIndex contentIndex;
+    std::vector<ofxScrollViewRect> dirtyContentRects;
+    
+    ofxScrollViewTouchTable touchPoints;
+    ofxScrollViewTouchPoint touchDownPointLast;
+};
@@ -0,0 +1,175 @@
+//
+//  ofxScrollViewCoreGroup.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewCoreGroup.h"
+#include <algorithm>
+
+//--------------------------------------------------------------
+ofxScrollViewCoreGroup::ofxScrollViewCoreGroup() {
+    mouseView = NULL;
+    numOfTouches = 0;
+}
+
+ofxScrollViewCoreGroup::~ofxScrollViewCoreGroup() {
+    //
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCoreGroup::add(ofxScrollViewCore * view) {
+    if(view == NULL) {
+        return;
+    }
+    if(std::find(views.begin(), views.end(), view) != views.end()) {
+        return;
+    }
+    views.push_back(view);
+}
+
+void ofxScrollViewCoreGroup::remove(ofxScrollViewCore * view) {
+    std::vector<ofxScrollViewCore *>::iterator it = std::find(views.begin(), views.end(), view);
+    if(it == views.end()) {
+        return;
+    }
+    views.erase(it);
+    
+    if(mouseView == view) {
+        mouseView = NULL;
+    }
+    for(int i=numOfTouches-1; i>=0; i--) {
+        if(touchViews[i] == view) {
+            removeTouch(i);
+        }
+    }
+}
+
+void ofxScrollViewCoreGroup::clear() {
+    views.clear();
+    
+    mouseView = NULL;
+    numOfTouches = 0;
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewCoreGroup::size() {
+    return views.size();
+}
+
+ofxScrollViewCore * ofxScrollViewCoreGroup::get(int index) {
+    if(index < 0 || index >= views.size()) {
+        return NULL;
+    }
+    return views[index];
+}
+
+ofxScrollViewCore * ofxScrollViewCoreGroup::getViewAtScreenPoint(float x, float y) {
+    for(int i=views.size()-1; i>=0; i--) {
+        if(views[i]->getWindowRect().inside(x, y) == true) {
+            return views[i];
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCoreGroup::update() {
+    for(int i=0; i<views.size(); i++) {
+        views[i]->update();
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCoreGroup::mousePressed(int x, int y, int button) {
+    mouseView = getViewAtScreenPoint(x, y);
+    if(mouseView == NULL) {
+        return;
+    }
+    mouseView->mousePressed(x, y, button);
+}
+
+void ofxScrollViewCoreGroup::mouseDragged(int x, int y, int button) {
+    if(mouseView == NULL) {
+        return;
+    }
+    mouseView->mouseDragged(x, y, button);
+}
+
+void ofxScrollViewCoreGroup::mouseReleased(int x, int y, int button) {
+    if(mouseView == NULL) {
+        return;
+    }
+    mouseView->mouseReleased(x, y, button);
+    mouseView = NULL;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewCoreGroup::touchDown(int x, int y, int id) {
+    ofxScrollViewCore * view = getViewAtScreenPoint(x, y);
+    if(view == NULL) {
+        return;
+    }
+    int touchIndex = findTouch(id);
+    if(touchIndex == -1) {
+        if(numOfTouches == kTouchesMax) {
+            return; // out of slots.
+        }
+        touchIndex = numOfTouches++;
+        touchIDs[touchIndex] = id;
+    }
+    touchViews[touchIndex] = view;
+    view->touchDown(x, y, id);
+}
+
+void ofxScrollViewCoreGroup::touchMoved(int x, int y, int id) {
+    int touchIndex = findTouch(id);
+    if(touchIndex == -1) {
+        return;
+    }
+    touchViews[touchIndex]->touchMoved(x, y, id);
+}
+
+void ofxScrollViewCoreGroup::touchUp(int x, int y, int id) {
+    int touchIndex = findTouch(id);
+    if(touchIndex == -1) {
+        return;
+    }
+    ofxScrollViewCore * view = touchViews[touchIndex];
+    removeTouch(touchIndex);
+    view->touchUp(x, y, id);
+}
+
+void ofxScrollViewCoreGroup::touchDoubleTap(int x, int y, int id) {
+    ofxScrollViewCore * view = getViewAtScreenPoint(x, y);
+    if(view == NULL) {
+        return;
+    }
+    view->touchDoubleTap(x, y, id);
+}
+
+void ofxScrollViewCoreGroup::touchCancelled(int x, int y, int id) {
+    int touchIndex = findTouch(id);
+    if(touchIndex == -1) {
+        return;
+    }
+    ofxScrollViewCore * view = touchViews[touchIndex];
+    removeTouch(touchIndex);
+    view->touchCancelled(x, y, id);
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewCoreGroup::findTouch(int touchID) {
+    for(int i=0; i<numOfTouches; i++) {
+        if(touchIDs[i] == touchID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ofxScrollViewCoreGroup::removeTouch(int touchIndex) {
+    numOfTouches -= 1;
+    touchIDs[touchIndex] = touchIDs[numOfTouches]; // order doesn't matter, move the last one into the gap.
+    touchViews[touchIndex] = touchViews[numOfTouches];
+}
@@ -0,0 +1,59 @@
+//
+//  ofxScrollViewCoreGroup.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  routes input to the scroll view under the pointer, and updates all of its views with one call.
+//  update() is a convenience, it costs the same as calling update() on each view.
+//
+
+#pragma once
+
+#include "ofxScrollViewCore.h"
+#include <vector>
+
+//--------------------------------------------------------------
+class ofxScrollViewCoreGroup {
+
+public:
+    
+    ofxScrollViewCoreGroup();
+    virtual ~ofxScrollViewCoreGroup();
+    
+    void add(ofxScrollViewCore * view);
+    void remove(ofxScrollViewCore * view);
+    void clear();
+    
+    int size();
+    ofxScrollViewCore * get(int index);
+    ofxScrollViewCore * getViewAtScreenPoint(float x, float y); // views added last are on top.
+    
+    virtual void update();  // update() on every view, in the order they were added.
+    
+    //--------------------------------------------------------------
+    virtual void mousePressed(int x, int y, int button);
+    virtual void mouseDragged(int x, int y, int button);
+    virtual void mouseReleased(int x, int y, int button);
+    
+    virtual void touchDown(int x, int y, int id);
+    virtual void touchMoved(int x, int y, int id);
+    virtual void touchUp(int x, int y, int id);
+    virtual void touchDoubleTap(int x, int y, int id);
+    virtual void touchCancelled(int x, int y, int id);
+    
+    //--------------------------------------------------------------
+    std::vector<ofxScrollViewCore *> views;
+    
+    ofxScrollViewCore * mouseView;
+    
+    //-------------------------------------------------------------- touches, fixed slots keyed by id so touch events never allocate.
+    static const int kTouchesMax = 10;
+    int touchIDs[kTouchesMax];
+    ofxScrollViewCore * touchViews[kTouchesMax];
+    int numOfTouches;
+    
+protected:
+    
+    int findTouch(int touchID);
+    void removeTouch(int touchIndex);
+};
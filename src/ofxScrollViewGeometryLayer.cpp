@@ -0,0 +1,190 @@
+//
+//  ofxScrollViewGeometryLayer.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewGeometryLayer.h"
+
+//--------------------------------------------------------------
+ofxScrollViewGeometryLayer::ofxScrollViewGeometryLayer() {
+    lineWidth = 1.0;
+    bLineWidthScreenSpace = true;
+    halfWidth = 0;
+    numOfUploads = 0;
+    bBuilt = false;
+    bGeometryDirty = false;
+    bPositionsDirty = false;
+}
+
+ofxScrollViewGeometryLayer::~ofxScrollViewGeometryLayer() {
+    //
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGeometryLayer::setup(const ofxScrollViewGeometryBuilder & value) {
+    builder = value;
+    bBuilt = false; // built on the next update.
+}
+
+void ofxScrollViewGeometryLayer::clear() {
+    linePoints.clear();
+    lineColors.clear();
+    bGeometryDirty = true;
+}
+
+void ofxScrollViewGeometryLayer::setLineWidth(float value, bool bScreenSpace) {
+    lineWidth = MAX(value, 0);
+    bLineWidthScreenSpace = bScreenSpace;
+    bPositionsDirty = true;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGeometryLayer::addLine(const ofVec2f & p0, const ofVec2f & p1, const ofColor & color) {
+    linePoints.push_back(p0);
+    linePoints.push_back(p1);
+    lineColors.push_back(ofFloatColor(color));
+    bGeometryDirty = true;
+}
+
+void ofxScrollViewGeometryLayer::addRect(const ofRectangle & rect, const ofColor & color) {
+    float x0 = rect.x;
+    float y0 = rect.y;
+    float x1 = rect.x + rect.width;
+    float y1 = rect.y + rect.height;
+    addLine(ofVec2f(x0, y0), ofVec2f(x1, y0), color);
+    addLine(ofVec2f(x1, y0), ofVec2f(x1, y1), color);
+    addLine(ofVec2f(x1, y1), ofVec2f(x0, y1), color);
+    addLine(ofVec2f(x0, y1), ofVec2f(x0, y0), color);
+}
+
+void ofxScrollViewGeometryLayer::addGrid(const ofRectangle & rect, int numOfCols, int numOfRows, const ofColor & color) {
+    for(int i=1; i<numOfCols; i++) {
+        float x = rect.x + (rect.width * i) / numOfCols;
+        addLine(ofVec2f(x, rect.y), ofVec2f(x, rect.y + rect.height), color);
+    }
+    for(int i=1; i<numOfRows; i++) {
+        float y = rect.y + (rect.height * i) / numOfRows;
+        addLine(ofVec2f(rect.x, y), ofVec2f(rect.x + rect.width, y), color);
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGeometryLayer::update(ofxScrollView & scrollView) {
+    
+    ofRectangle contentRect = scrollView.getContentRect();
+    if(builder && (bBuilt == false || contentRect != builtContentRect)) {
+        clear();
+        builder(*this, contentRect);
+        builtContentRect = contentRect;
+        bBuilt = true;
+    }
+    
+    ofVec2f renderOriginNew = ofxScrollView::toOf(scrollView.getRenderOrigin());
+    if(renderOriginNew != renderOrigin) {
+        renderOrigin = renderOriginNew;
+        bPositionsDirty = true;
+    }
+    
+    float halfWidthNew = lineWidth * 0.5;
+    if(bLineWidthScreenSpace == true) {
+        float scale = scrollView.getTransform().scale;
+        halfWidthNew = (scale > 0) ? (halfWidthNew / scale) : 0;
+    }
+    if(halfWidthNew != halfWidth) {
+        halfWidth = halfWidthNew;
+        bPositionsDirty = true;
+    }
+    
+    if(bGeometryDirty == true) {
+        
+        int numOfLines = lineColors.size();
+        colors.resize(numOfLines * 4);
+        for(int i=0; i<numOfLines; i++) {
+            colors[i * 4 + 0] = lineColors[i];
+            colors[i * 4 + 1] = lineColors[i];
+            colors[i * 4 + 2] = lineColors[i];
+            colors[i * 4 + 3] = lineColors[i];
+        }
+        
+        indices.resize(MIN(numOfLines, kLinesPerVbo) * 6);
+        for(int i=0; i<indices.size()/6; i++) {
+            ofIndexType vertexIndex = i * 4;
+            indices[i * 6 + 0] = vertexIndex + 0;
+            indices[i * 6 + 1] = vertexIndex + 1;
+            indices[i * 6 + 2] = vertexIndex + 2;
+            indices[i * 6 + 3] = vertexIndex + 0;
+            indices[i * 6 + 4] = vertexIndex + 2;
+            indices[i * 6 + 5] = vertexIndex + 3;
+        }
+        updatePositions();
+        
+        vbos.clear();
+        vbos.resize((numOfLines + kLinesPerVbo - 1) / kLinesPerVbo);
+        for(int i=0; i<vbos.size(); i++) {
+            int lineStart = i * kLinesPerVbo;
+            int numOfVboLines = MIN(numOfLines - lineStart, kLinesPerVbo);
+            vbos[i].setVertexData(&positions[lineStart * 4], numOfVboLines * 4, GL_DYNAMIC_DRAW);
+            vbos[i].setColorData(&colors[lineStart * 4], numOfVboLines * 4, GL_STATIC_DRAW);
+            vbos[i].setIndexData(&indices[0], numOfVboLines * 6, GL_STATIC_DRAW);
+        }
+        numOfUploads += 1;
+        
+        bGeometryDirty = false;
+        bPositionsDirty = false;
+    
+    } else if(bPositionsDirty == true) {
+        
+        updatePositions();
+        int numOfLines = lineColors.size();
+        for(int i=0; i<vbos.size(); i++) {
+            int lineStart = i * kLinesPerVbo;
+            int numOfVboLines = MIN(numOfLines - lineStart, kLinesPerVbo);
+            vbos[i].updateVertexData(&positions[lineStart * 4], numOfVboLines * 4);
+        }
+        numOfUploads += 1;
+        
+        bPositionsDirty = false;
+    }
+}
+
+void ofxScrollViewGeometryLayer::updatePositions() {
+    int numOfLines = lineColors.size();
+    positions.resize(numOfLines * 4);
+    
+    for(int i=0; i<numOfLines; i++) {
+        ofVec2f p0 = linePoints[i * 2 + 0] - renderOrigin;
+        ofVec2f p1 = linePoints[i * 2 + 1] - renderOrigin;
+        
+        // d along the line and n across it, both half the width long. the ends are pushed out by d for square caps.
+        ofVec2f d = p1 - p0;
+        float length = d.length();
+        d = (length > 0) ? (d * (halfWidth / length)) : ofVec2f(halfWidth, 0);
+        ofVec2f n(-d.y, d.x);
+        
+        p0 -= d;
+        p1 += d;
+        positions[i * 4 + 0] = ofVec3f(p0.x - n.x, p0.y - n.y, 0);
+        positions[i * 4 + 1] = ofVec3f(p1.x - n.x, p1.y - n.y, 0);
+        positions[i * 4 + 2] = ofVec3f(p1.x + n.x, p1.y + n.y, 0);
+        positions[i * 4 + 3] = ofVec3f(p0.x + n.x, p0.y + n.y, 0);
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGeometryLayer::draw() {
+    int numOfLines = lineColors.size();
+    for(int i=0; i<vbos.size(); i++) {
+        int numOfVboLines = MIN(numOfLines - i * kLinesPerVbo, kLinesPerVbo);
+        vbos[i].drawElements(GL_TRIANGLES, numOfVboLines * 6);
+    }
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewGeometryLayer::getNumOfLines() {
+    return lineColors.size();
+}
+
+int ofxScrollViewGeometryLayer::getNumOfUploads() {
+    return numOfUploads;
+}
@@ -0,0 +1,74 @@
+//
+//  ofxScrollViewGeometryLayer.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollView.h"
+
+class ofxScrollViewGeometryLayer;
+
+//--------------------------------------------------------------
+typedef std::function<void(ofxScrollViewGeometryLayer & layer, const ofRectangle & contentRect)> ofxScrollViewGeometryBuilder;
+
+//--------------------------------------------------------------
+// static line work like background grids, rulers and outlines, drawn with one call.
+// lines are added in content coordinates, by hand or from a builder callback
+// that runs again whenever the scroll view content rect changes.
+// every line is a quad with square caps, so widths above one pixel work on every renderer.
+// the quads go into as few vbos as the index type allows, 16384 lines each since ofIndexType is 16 bit on gles.
+// with a screen space line width the quads are widened as the scale changes,
+// which only re-uploads the positions, and only on frames where the drawn scale changed.
+// draw() between scrollView.begin() and end(), or inside drawContent().
+//--------------------------------------------------------------
+class ofxScrollViewGeometryLayer {
+
+public:
+    
+    ofxScrollViewGeometryLayer();
+    ~ofxScrollViewGeometryLayer();
+    
+    void setup(const ofxScrollViewGeometryBuilder & builder);
+    void clear();
+    
+    void setLineWidth(float value, bool bScreenSpace=true);  // default 1 screen pixel, otherwise in content units.
+    
+    void addLine(const ofVec2f & p0, const ofVec2f & p1, const ofColor & color);
+    void addRect(const ofRectangle & rect, const ofColor & color);     // outline.
+    void addGrid(const ofRectangle & rect, int numOfCols, int numOfRows, const ofColor & color);   // the lines between cells.
+    
+    void update(ofxScrollView & scrollView);
+    void draw();
+    
+    int getNumOfLines();
+    int getNumOfUploads();      // full geometry uploads plus position only uploads.
+    
+    static const int kLinesPerVbo = 16384;  // 65536 vertices, all a 16 bit index can reach.
+    
+    vector<ofVbo> vbos;
+
+protected:
+    
+    void updatePositions();
+    
+    ofxScrollViewGeometryBuilder builder;
+    float lineWidth;
+    bool bLineWidthScreenSpace;
+    
+    vector<ofVec2f> linePoints;     // two per line, in content.
+    vector<ofFloatColor> lineColors;
+    vector<ofVec3f> positions;      // four per line, relative to the render origin.
+    vector<ofFloatColor> colors;
+    vector<ofIndexType> indices;    // the same for every vbo, relative to its first vertex.
+    
+    ofRectangle builtContentRect;
+    ofVec2f renderOrigin;
+    float halfWidth;                // half the line width in content units, as the positions were built.
+    int numOfUploads;
+    bool bBuilt;
+    bool bGeometryDirty;
+    bool bPositionsDirty;
+};
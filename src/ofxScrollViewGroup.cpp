@@ -0,0 +1,88 @@
+//
+//  ofxScrollViewGroup.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewGroup.h"
+
+//--------------------------------------------------------------
+ofxScrollViewGroup::ofxScrollViewGroup() {
+    bUserInteractionEnabled = false;
+    setUserInteraction(true);
+}
+
+ofxScrollViewGroup::~ofxScrollViewGroup() {
+    setUserInteraction(false);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGroup::setUserInteraction(bool bEnable) {
+    if(bUserInteractionEnabled == bEnable) {
+        return;
+    }
+    if(bUserInteractionEnabled == true) {
+        bUserInteractionEnabled = false;
+        
+#ifdef TARGET_OPENGLES
+        ofRemoveListener(ofEvents().touchDown, this, &ofxScrollViewGroup::touchDown);
+        ofRemoveListener(ofEvents().touchMoved, this, &ofxScrollViewGroup::touchMoved);
+        ofRemoveListener(ofEvents().touchUp, this, &ofxScrollViewGroup::touchUp);
+#else
+        ofRemoveListener(ofEvents().mousePressed, this, &ofxScrollViewGroup::mousePressed);
+        ofRemoveListener(ofEvents().mouseDragged, this, &ofxScrollViewGroup::mouseDragged);
+        ofRemoveListener(ofEvents().mouseReleased, this, &ofxScrollViewGroup::mouseReleased);
+#endif
+        
+    } else {
+        bUserInteractionEnabled = true;
+        
+#ifdef TARGET_OPENGLES
+        ofAddListener(ofEvents().touchDown, this, &ofxScrollViewGroup::touchDown);
+        ofAddListener(ofEvents().touchMoved, this, &ofxScrollViewGroup::touchMoved);
+        ofAddListener(ofEvents().touchUp, this, &ofxScrollViewGroup::touchUp);
+#else
+        ofAddListener(ofEvents().mousePressed, this, &ofxScrollViewGroup::mousePressed);
+        ofAddListener(ofEvents().mouseDragged, this, &ofxScrollViewGroup::mouseDragged);
+        ofAddListener(ofEvents().mouseReleased, this, &ofxScrollViewGroup::mouseReleased);
+#endif
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewGroup::add(ofxScrollView * view) {
+    if(view == NULL || viewsUserInteraction.count(view) > 0) {
+        return;
+    }
+    viewsUserInteraction[view] = view->bUserInteractionEnabled;
+    view->setUserInteraction(false); // the group routes input from here on.
+    ofxScrollViewCoreGroup::add(view);
+}
+
+void ofxScrollViewGroup::remove(ofxScrollView * view) {
+    std::map<ofxScrollView *, bool>::iterator it = viewsUserInteraction.find(view);
+    if(it == viewsUserInteraction.end()) {
+        return;
+    }
+    ofxScrollViewCoreGroup::remove(view);
+    view->setUserInteraction(it->second);
+    viewsUserInteraction.erase(it);
+}
+
+void ofxScrollViewGroup::clear() {
+    std::map<ofxScrollView *, bool>::iterator it;
+    for(it = viewsUserInteraction.begin(); it != viewsUserInteraction.end(); ++it) {
+        it->first->setUserInteraction(it->second);
+    }
+    viewsUserInteraction.clear();
+    ofxScrollViewCoreGroup::clear();
+}
+
+//--------------------------------------------------------------
+ofxScrollView * ofxScrollViewGroup::get(int index) {
+    return static_cast<ofxScrollView *>(ofxScrollViewCoreGroup::get(index));
+}
+
+ofxScrollView * ofxScrollViewGroup::getViewAtScreenPoint(float x, float y) {
+    return static_cast<ofxScrollView *>(ofxScrollViewCoreGroup::getViewAtScreenPoint(x, y));
+}
@@ -0,0 +1,65 @@
+//
+//  ofxScrollViewGroup.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofxScrollView.h"
+#include "ofxScrollViewCoreGroup.h"
+
+//--------------------------------------------------------------
+// many ofxScrollView's updated together.
+// the group listens to mouse or touch events once and hands them to the view under the pointer,
+// the views added stop listening for themselves, and get their own setting back when removed.
+//--------------------------------------------------------------
+class ofxScrollViewGroup : public ofxScrollViewCoreGroup {
+    
+public:
+    
+    ofxScrollViewGroup();
+    ~ofxScrollViewGroup();
+    
+    void setUserInteraction(bool bEnable);
+    
+    void add(ofxScrollView * view);
+    void remove(ofxScrollView * view);
+    void clear();
+    
+    ofxScrollView * get(int index);
+    ofxScrollView * getViewAtScreenPoint(float x, float y);
+    
+    bool bUserInteractionEnabled;
+    std::map<ofxScrollView *, bool> viewsUserInteraction;  // what each view had before it was added.
+    
+    //----------------------------------------------------------
+    using ofxScrollViewCoreGroup::mousePressed;
+    using ofxScrollViewCoreGroup::mouseDragged;
+    using ofxScrollViewCoreGroup::mouseReleased;
+    
+    virtual void mouseDragged(ofMouseEventArgs & mouse){
+        mouseDragged(mouse.x,mouse.y,mouse.button);
+    }
+    virtual void mousePressed(ofMouseEventArgs & mouse){
+        mousePressed(mouse.x,mouse.y,mouse.button);
+    }
+    virtual void mouseReleased(ofMouseEventArgs & mouse){
+        mouseReleased(mouse.x,mouse.y,mouse.button);
+    }
+    
+    //----------------------------------------------------------
+    using ofxScrollViewCoreGroup::touchDown;
+    using ofxScrollViewCoreGroup::touchMoved;
+    using ofxScrollViewCoreGroup::touchUp;
+    
+    virtual void touchDown(ofTouchEventArgs &touch) {
+        touchDown(touch.x, touch.y, touch.id);
+    }
+    virtual void touchMoved(ofTouchEventArgs &touch) {
+        touchMoved(touch.x, touch.y, touch.id);
+    }
+    virtual void touchUp(ofTouchEventArgs &touch) {
+        touchUp(touch.x, touch.y, touch.id);
+    }
+};
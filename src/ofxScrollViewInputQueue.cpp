@@ -0,0 +1,134 @@
+//
+//  ofxScrollViewInputQueue.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewInputQueue.h"
+
+//--------------------------------------------------------------
+ofxScrollViewInputQueue::ofxScrollViewInputQueue() {
+    sampleFirst = 0;
+    numOfSamples = 0;
+    
+    setup(64); // a quarter of a second at 240 Hz.
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewInputQueue::setup(int capacity) {
+    samples.clear();
+    samples.resize(capacity > 2 ? capacity : 2);
+    clear();
+}
+
+void ofxScrollViewInputQueue::clear() {
+    sampleFirst = 0;
+    numOfSamples = 0;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewInputQueue::add(const ofxScrollViewVec2 & pos, double timeInSec) {
+    int capacity = samples.size();
+    int index = sampleFirst + numOfSamples;
+    if(index >= capacity) {
+        index -= capacity;
+    }
+    if(numOfSamples == capacity) {
+        sampleFirst += 1; // full, drop the oldest.
+        if(sampleFirst == capacity) {
+            sampleFirst = 0;
+        }
+    } else {
+        numOfSamples += 1;
+    }
+    samples[index].pos = pos;
+    samples[index].timeInSec = timeInSec;
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewInputQueue::getNumOfSamples() {
+    return numOfSamples;
+}
+
+const ofxScrollViewInputSample & ofxScrollViewInputQueue::getSample(int index) {
+    index += sampleFirst;
+    if(index >= (int)samples.size()) {
+        index -= samples.size();
+    }
+    return samples[index];
+}
+
+const ofxScrollViewInputSample & ofxScrollViewInputQueue::getSampleLast() {
+    return getSample(numOfSamples - 1);
+}
+
+int ofxScrollViewInputQueue::getNumOfSamplesSince(double timeInSec) {
+    int count = 0;
+    for(int i=numOfSamples-1; i>=0; i--) {
+        if(getSample(i).timeInSec < timeInSec) {
+            break;
+        }
+        count += 1;
+    }
+    return count;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewInputQueue::getVelocity(double timeNow, float timeWindowInSec, ofxScrollViewVec2 & velocity) {
+    
+    // least squares slope of position against time in one pass.
+    // sample times are absolute doubles, only their offsets from the last sample
+    // go into the fit, so the sums stay small however long the clock has run.
+    
+    int count = getNumOfSamplesSince(timeNow - timeWindowInSec);
+    if(count < 2) {
+        return false;
+    }
+    
+    const ofxScrollViewInputSample & sampleLast = getSampleLast();
+    double t = 0;
+    double x = 0;
+    double y = 0;
+    double tt = 0;
+    double tx = 0;
+    double ty = 0;
+    for(int i=numOfSamples-count; i<numOfSamples; i++) {
+        const ofxScrollViewInputSample & sample = getSample(i);
+        float st = sample.timeInSec - sampleLast.timeInSec;
+        double sx = sample.pos.x - sampleLast.pos.x;
+        double sy = sample.pos.y - sampleLast.pos.y;
+        t += st;
+        x += sx;
+        y += sy;
+        tt += st * st;
+        tx += st * sx;
+        ty += st * sy;
+    }
+    double denom = count * tt - t * t;
+    if(denom <= 1e-12) {
+        return false; // all in the same instant.
+    }
+    
+    velocity.set((count * tx - t * x) / denom, (count * ty - t * y) / denom);
+    return true;
+}
+
+ofxScrollViewVec2 ofxScrollViewInputQueue::getPredictedPosition(double timeNow, float timeAheadInSec, float timeWindowInSec) {
+    if(numOfSamples == 0) {
+        return ofxScrollViewVec2();
+    }
+    
+    const ofxScrollViewInputSample & sampleLast = getSampleLast();
+    ofxScrollViewVec2 velocity;
+    if(timeAheadInSec <= 0 || getVelocity(timeNow, timeWindowInSec, velocity) == false) {
+        return sampleLast.pos;
+    }
+    
+    // the last sample can be up to an input period old, the extrapolation covers that gap too
+    // but never more than twice the time asked for.
+    float timeAhead = (float)(timeNow - sampleLast.timeInSec) + timeAheadInSec;
+    if(timeAhead > timeAheadInSec * 2) {
+        timeAhead = timeAheadInSec * 2;
+    }
+    return sampleLast.pos + velocity * timeAhead;
+}
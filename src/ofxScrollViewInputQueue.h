@@ -0,0 +1,54 @@
+//
+//  ofxScrollViewInputQueue.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  keeps every timestamped drag sample that comes in between updates,
+//  not just the last one, so fast digitizers aren't thrown away.
+//  velocity is a least squares fit over the newest samples
+//  and the position can be extrapolated to when the frame will be shown.
+//  fixed capacity, the oldest samples are overwritten and nothing is allocated after setup().
+//
+
+#pragma once
+
+#include "ofxScrollViewTypes.h"
+#include <vector>
+
+//--------------------------------------------------------------
+struct ofxScrollViewInputSample {
+    ofxScrollViewVec2 pos;
+    double timeInSec;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewInputQueue {
+
+public:
+    
+    ofxScrollViewInputQueue();
+    
+    void setup(int capacity);
+    void clear();
+    
+    void add(const ofxScrollViewVec2 & pos, double timeInSec);
+    
+    int getNumOfSamples();
+    const ofxScrollViewInputSample & getSample(int index);   // 0 is the oldest kept.
+    const ofxScrollViewInputSample & getSampleLast();
+    int getNumOfSamplesSince(double timeInSec);
+    
+    // velocity in pixels per second over the samples no older than timeWindowInSec before timeNow.
+    // false when there are fewer than two samples in the window, or they all have the same time.
+    bool getVelocity(double timeNow, float timeWindowInSec, ofxScrollViewVec2 & velocity);
+    
+    // the last sample carried forward to timeAheadInSec after timeNow with the fitted velocity.
+    // stays on the last sample once the window has no movement in it, like a finger held still.
+    ofxScrollViewVec2 getPredictedPosition(double timeNow, float timeAheadInSec, float timeWindowInSec);
+
+protected:
+    
+    std::vector<ofxScrollViewInputSample> samples;
+    int sampleFirst;
+    int numOfSamples;
+};
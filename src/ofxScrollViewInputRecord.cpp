@@ -0,0 +1,188 @@
+//
+//  ofxScrollViewInputRecord.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewInputRecord.h"
+#include <cstring>
+#include <fstream>
+
+//--------------------------------------------------------------
+static char const kInputRecordMagic[4] = {'O', 'S', 'V', 'I'};
+static uint32_t const kInputRecordVersion = 3;  // 2, event times are doubles. 3, touch ids are 32 bit.
+static_assert(sizeof(ofxScrollViewInputEvent) == 24, "events are written to file as is");
+
+//--------------------------------------------------------------
+ofxScrollViewInputRecorder::ofxScrollViewInputRecorder() {
+    bRecording = false;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewInputRecorder::start() {
+    events.clear();
+    bRecording = true;
+}
+
+void ofxScrollViewInputRecorder::stop() {
+    bRecording = false;
+}
+
+bool ofxScrollViewInputRecorder::isRecording() {
+    return bRecording;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewInputRecorder::record(ofxScrollViewInputEventType type, double timeInSec, float x, float y, int touchID) {
+    if(bRecording == false) {
+        return;
+    }
+    
+    ofxScrollViewInputEvent event = {};
+    event.timeInSec = timeInSec;
+    event.x = x;
+    event.y = y;
+    event.touchID = touchID;
+    event.type = type;
+    events.push_back(event);
+}
+
+const std::vector<ofxScrollViewInputEvent> & ofxScrollViewInputRecorder::getEvents() {
+    return events;
+}
+
+bool ofxScrollViewInputRecorder::save(const std::string & path) {
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(file.is_open() == false) {
+        return false;
+    }
+    
+    ofxScrollViewInputRecordHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kInputRecordMagic, sizeof(kInputRecordMagic));
+    header.version = kInputRecordVersion;
+    header.numOfEvents = events.size();
+    
+    file.write((const char *)&header, sizeof(header));
+    if(events.size() > 0) {
+        file.write((const char *)&events[0], sizeof(ofxScrollViewInputEvent) * events.size());
+    }
+    return file.good();
+}
+
+//--------------------------------------------------------------
+ofxScrollViewInputPlayer::ofxScrollViewInputPlayer() {
+    view = NULL;
+    eventIndex = 0;
+    timeInSec = 0;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewInputPlayer::load(const std::string & path) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if(file.is_open() == false) {
+        return false;
+    }
+    
+    ofxScrollViewInputRecordHeader header;
+    file.read((char *)&header, sizeof(header));
+    bool bValid = true;
+    bValid = bValid && file.good();
+    bValid = bValid && (memcmp(header.magic, kInputRecordMagic, sizeof(kInputRecordMagic)) == 0);
+    bValid = bValid && (header.version == kInputRecordVersion);
+    if(bValid == false) {
+        return false;
+    }
+    
+    // numOfEvents comes from the file, check it against what's left before allocating for it.
+    std::streamoff eventsStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(eventsStart);
+    uint64_t eventsSize = (uint64_t)header.numOfEvents * sizeof(ofxScrollViewInputEvent);
+    if(eventsStart < 0 || fileSize < eventsStart || eventsSize > (uint64_t)(fileSize - eventsStart)) {
+        return false; // truncated or corrupt.
+    }
+    
+    std::vector<ofxScrollViewInputEvent> fileEvents(header.numOfEvents);
+    if(fileEvents.size() > 0) {
+        file.read((char *)&fileEvents[0], sizeof(ofxScrollViewInputEvent) * fileEvents.size());
+        if(file.good() == false) {
+            return false; // truncated.
+        }
+    }
+    
+    setEvents(fileEvents);
+    return true;
+}
+
+void ofxScrollViewInputPlayer::setEvents(const std::vector<ofxScrollViewInputEvent> & value) {
+    events = value;
+    rewind();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewInputPlayer::setup(ofxScrollViewCore * value) {
+    view = value;
+    if(view != NULL) {
+        view->setClock(std::bind(&ofxScrollViewInputPlayer::getTimeInSec, this));
+    }
+    rewind();
+}
+
+void ofxScrollViewInputPlayer::rewind() {
+    eventIndex = 0;
+    timeInSec = (events.size() > 0) ? events[0].timeInSec : 0;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewInputPlayer::update() {
+    if(view == NULL) {
+        return false;
+    }
+    
+    while(eventIndex < events.size()) {
+        const ofxScrollViewInputEvent & event = events[eventIndex++];
+        timeInSec = event.timeInSec;
+        
+        if(event.type == OFX_SCROLL_VIEW_INPUT_UPDATE) {
+            view->update();
+            return true;
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_DOWN) {
+            view->touchDown(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_MOVED) {
+            view->touchMoved(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_UP) {
+            view->touchUp(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_DOUBLE_TAP) {
+            view->touchDoubleTap(event.x, event.y, event.touchID);
+        } else if(event.type == OFX_SCROLL_VIEW_INPUT_TOUCH_CANCELLED) {
+            view->touchCancelled(event.x, event.y, event.touchID);
+        }
+    }
+    
+    return false;
+}
+
+bool ofxScrollViewInputPlayer::isFinished() {
+    return eventIndex >= events.size();
+}
+
+//--------------------------------------------------------------
+double ofxScrollViewInputPlayer::getTimeInSec() {
+    return timeInSec;
+}
+
+int ofxScrollViewInputPlayer::getNumOfEvents() {
+    return events.size();
+}
+
+int ofxScrollViewInputPlayer::getNumOfUpdates() {
+    int numOfUpdates = 0;
+    for(int i=0; i<events.size(); i++) {
+        if(events[i].type == OFX_SCROLL_VIEW_INPUT_UPDATE) {
+            numOfUpdates += 1;
+        }
+    }
+    return numOfUpdates;
+}
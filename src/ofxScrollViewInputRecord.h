@@ -0,0 +1,78 @@
+//
+//  ofxScrollViewInputRecord.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  records the touch input and update() times of a scroll view to a small binary file
+//  and plays it back through the same entry points on a virtual clock,
+//  so a real session can be run again, frame for frame, against a new build.
+//  mouse input goes through the touch entry points, so it's recorded as touches.
+//
+//  file layout, all values little endian:
+//   header     ofxScrollViewInputRecordHeader.
+//   events     ofxScrollViewInputEvent (ofxScrollViewTypes.h), numOfEvents of them in the order they happened.
+//
+
+#pragma once
+
+#include "ofxScrollViewCore.h"
+#include <stdint.h>
+#include <string>
+
+//--------------------------------------------------------------
+struct ofxScrollViewInputRecordHeader {
+    char magic[4];          // "OSVI"
+    uint32_t version;
+    uint32_t numOfEvents;
+    uint32_t reserved;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewInputRecorder {
+
+public:
+    
+    ofxScrollViewInputRecorder();
+    
+    void start();   // clears anything recorded before.
+    void stop();
+    bool isRecording();
+    
+    void record(ofxScrollViewInputEventType type, double timeInSec, float x=0, float y=0, int touchID=0);
+    
+    const std::vector<ofxScrollViewInputEvent> & getEvents();
+    bool save(const std::string & path);
+
+protected:
+    
+    bool bRecording;
+    std::vector<ofxScrollViewInputEvent> events;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewInputPlayer {
+
+public:
+    
+    ofxScrollViewInputPlayer();
+    
+    bool load(const std::string & path);
+    void setEvents(const std::vector<ofxScrollViewInputEvent> & events);
+    
+    void setup(ofxScrollViewCore * view); // replaces the clock of the view with the recorded one.
+    void rewind();
+    
+    bool update();  // feeds the events up to the next recorded update() and runs it, false once finished.
+    bool isFinished();
+    
+    double getTimeInSec();
+    int getNumOfEvents();
+    int getNumOfUpdates();
+
+protected:
+    
+    ofxScrollViewCore * view;
+    std::vector<ofxScrollViewInputEvent> events;
+    int eventIndex;
+    double timeInSec;
+};
@@ -0,0 +1,372 @@
+//
+//  ofxScrollViewLabelLayer.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewLabelLayer.h"
+
+//--------------------------------------------------------------
+static int const kGlyphPadding = 2; // keeps neighbouring glyphs from bleeding in when filtered.
+
+//--------------------------------------------------------------
+ofxScrollViewLabelLayer::ofxScrollViewLabelLayer() {
+    font = NULL;
+    labelScale = 1.0;
+    cullMargin = 256;
+    color = ofColor(0);
+    
+    atlasWidth = 0;
+    atlasHeight = 0;
+    atlasX = 0;
+    atlasY = 0;
+    atlasShelfHeight = 0;
+    
+    meshLodLevel = -1;
+    numOfMeshLabels = 0;
+    numOfMeshRebuilds = 0;
+    bMeshDirty = true;
+}
+
+ofxScrollViewLabelLayer::~ofxScrollViewLabelLayer() {
+    //
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewLabelLayer::setup(const ofRectangle & contentRect, int w, int h) {
+    atlasWidth = w;
+    atlasHeight = h;
+    atlas.allocate(atlasWidth, atlasHeight, GL_RGBA);
+    index.setup(ofxScrollView::toCore(contentRect));
+    clear();
+}
+
+void ofxScrollViewLabelLayer::clear() {
+    labels.clear();
+    glyphs.clear();
+    glyphsPending.clear();
+    index.clear();
+    labelIDs.clear();
+    meshes.clear();
+    
+    atlasX = 0;
+    atlasY = 0;
+    atlasShelfHeight = 0;
+    if(atlas.isAllocated() == true) {
+        atlas.begin();
+        ofClear(0, 0, 0, 0);
+        atlas.end();
+    }
+    
+    numOfMeshLabels = 0;
+    bMeshDirty = true;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewLabelLayer::setFont(ofTrueTypeFont * value) {
+    font = value;
+}
+
+void ofxScrollViewLabelLayer::setLabelScale(float value) {
+    labelScale = value;
+    
+    std::unordered_map<int, ofxScrollViewLabel>::iterator it;
+    for(it = labels.begin(); it != labels.end(); ++it) {
+        ofxScrollViewLabel & label = it->second;
+        label.rect = getLabelRect(label.pos, getGlyph(label.text));
+        index.move(it->first, ofxScrollView::toCore(label.rect));
+    }
+    bMeshDirty = true;
+}
+
+void ofxScrollViewLabelLayer::setCullMargin(float value) {
+    cullMargin = MAX(value, 0);
+}
+
+void ofxScrollViewLabelLayer::setColor(const ofColor & value) {
+    color = value;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewLabelLayer::addLabel(int labelID, const string & text, const ofVec2f & pos, int lodMin) {
+    if(hasLabel(labelID) == true) {
+        removeLabel(labelID);
+    }
+    
+    ofxScrollViewLabel & label = labels[labelID];
+    label.text = text;
+    label.pos = pos;
+    label.lodMin = lodMin;
+    label.rect = getLabelRect(pos, getGlyph(text));
+    index.insert(labelID, ofxScrollView::toCore(label.rect));
+    bMeshDirty = true;
+}
+
+void ofxScrollViewLabelLayer::setLabelText(int labelID, const string & text) {
+    std::unordered_map<int, ofxScrollViewLabel>::iterator it = labels.find(labelID);
+    if(it == labels.end() || it->second.text == text) {
+        return;
+    }
+    ofxScrollViewLabel & label = it->second;
+    label.text = text;
+    label.rect = getLabelRect(label.pos, getGlyph(text));
+    index.move(labelID, ofxScrollView::toCore(label.rect));
+    bMeshDirty = true;
+}
+
+void ofxScrollViewLabelLayer::moveLabel(int labelID, const ofVec2f & pos) {
+    std::unordered_map<int, ofxScrollViewLabel>::iterator it = labels.find(labelID);
+    if(it == labels.end()) {
+        return;
+    }
+    ofxScrollViewLabel & label = it->second;
+    label.pos = pos;
+    label.rect = getLabelRect(pos, getGlyph(label.text));
+    index.move(labelID, ofxScrollView::toCore(label.rect));
+    bMeshDirty = true;
+}
+
+void ofxScrollViewLabelLayer::removeLabel(int labelID) {
+    if(labels.erase(labelID) == 0) {
+        return;
+    }
+    index.remove(labelID); // its glyph stays in the atlas until the next repack.
+    bMeshDirty = true;
+}
+
+bool ofxScrollViewLabelLayer::hasLabel(int labelID) {
+    return labels.find(labelID) != labels.end();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewLabelLayer::update(ofxScrollView & scrollView) {
+    if(atlas.isAllocated() == false) {
+        return;
+    }
+    
+    rasterizeGlyphs();
+    
+    int lodLevel = scrollView.getLodLevel();
+    ofVec2f renderOrigin = ofxScrollView::toOf(scrollView.getRenderOrigin());
+    ofRectangle visibleRect = scrollView.getVisibleContentRect();
+    
+    bool bRebuild = bMeshDirty;
+    bRebuild = bRebuild || (lodLevel != meshLodLevel);
+    bRebuild = bRebuild || (renderOrigin != meshRenderOrigin);
+    bRebuild = bRebuild || (meshRect.inside(visibleRect) == false);
+    if(bRebuild == false) {
+        return;
+    }
+    
+    float scale = scrollView.getTransform().scale;
+    float margin = (scale > 0) ? (cullMargin / scale) : 0;
+    meshRect = visibleRect;
+    meshRect.x -= margin;
+    meshRect.y -= margin;
+    meshRect.width += margin * 2;
+    meshRect.height += margin * 2;
+    meshRenderOrigin = renderOrigin;
+    meshLodLevel = lodLevel;
+    
+    rebuildMesh(lodLevel);
+}
+
+void ofxScrollViewLabelLayer::draw() {
+    if(numOfMeshLabels == 0) {
+        return;
+    }
+    
+    ofPushStyle();
+    ofSetColor(color);
+    atlas.getTextureReference().bind();
+    for(int i=0; i<meshes.size(); i++) {
+        if(meshes[i].getNumVertices() > 0) {
+            meshes[i].draw();
+        }
+    }
+    atlas.getTextureReference().unbind();
+    ofPopStyle();
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewLabelLayer::getNumOfLabels() {
+    return labels.size();
+}
+
+int ofxScrollViewLabelLayer::getNumOfVisibleLabels() {
+    return numOfMeshLabels;
+}
+
+int ofxScrollViewLabelLayer::getNumOfGlyphs() {
+    return glyphs.size();
+}
+
+int ofxScrollViewLabelLayer::getNumOfMeshRebuilds() {
+    return numOfMeshRebuilds;
+}
+
+//--------------------------------------------------------------
+ofxScrollViewLabelGlyph & ofxScrollViewLabelLayer::getGlyph(const string & text) {
+    std::unordered_map<string, ofxScrollViewLabelGlyph>::iterator it = glyphs.find(text);
+    if(it != glyphs.end()) {
+        return it->second;
+    }
+    ofxScrollViewLabelGlyph & glyph = glyphs[text];
+    glyph.textRect = getTextRect(text);
+    glyphsPending.push_back(text);
+    return glyph;
+}
+
+ofRectangle ofxScrollViewLabelLayer::getTextRect(const string & text) {
+    if(font != NULL) {
+        return font->getStringBoundingBox(text, 0, 0);
+    }
+    return ofBitmapStringGetBoundingBox(text, 0, 0);
+}
+
+ofRectangle ofxScrollViewLabelLayer::getLabelRect(const ofVec2f & pos, const ofxScrollViewLabelGlyph & glyph) {
+    return ofRectangle(pos.x, pos.y, glyph.textRect.width * labelScale, glyph.textRect.height * labelScale);
+}
+
+bool ofxScrollViewLabelLayer::packGlyph(ofxScrollViewLabelGlyph & glyph) {
+    int w = ceil(glyph.textRect.width);
+    int h = ceil(glyph.textRect.height);
+    if(atlasX + w > atlasWidth) { // next shelf.
+        atlasX = 0;
+        atlasY += atlasShelfHeight + kGlyphPadding;
+        atlasShelfHeight = 0;
+    }
+    if(w > atlasWidth || atlasY + h > atlasHeight) {
+        return false;
+    }
+    glyph.atlasRect.set(atlasX, atlasY, w, h);
+    atlasX += w + kGlyphPadding;
+    atlasShelfHeight = MAX(atlasShelfHeight, h);
+    return true;
+}
+
+void ofxScrollViewLabelLayer::rasterizeGlyphs() {
+    if(glyphsPending.size() == 0) {
+        return;
+    }
+    
+    for(int i=0; i<glyphsPending.size(); i++) {
+        if(packGlyph(glyphs[glyphsPending[i]]) == false) {
+            repackAtlas(); // full, start again with only the strings still in use.
+            return;
+        }
+    }
+    drawGlyphs();
+}
+
+void ofxScrollViewLabelLayer::repackAtlas() {
+    glyphs.clear();
+    glyphsPending.clear();
+    
+    std::unordered_map<int, ofxScrollViewLabel>::iterator it;
+    for(it = labels.begin(); it != labels.end(); ++it) {
+        getGlyph(it->second.text);
+    }
+    
+    atlasX = 0;
+    atlasY = 0;
+    atlasShelfHeight = 0;
+    atlas.begin();
+    ofClear(0, 0, 0, 0);
+    atlas.end();
+    
+    // anything that still doesn't fit is left out rather than repacking every frame.
+    vector<string> glyphsPacked;
+    for(int i=0; i<glyphsPending.size(); i++) {
+        if(packGlyph(glyphs[glyphsPending[i]]) == true) {
+            glyphsPacked.push_back(glyphsPending[i]);
+        }
+    }
+    if(glyphsPacked.size() < glyphsPending.size()) {
+        ofLogWarning("ofxScrollViewLabelLayer", "atlas is full, some labels won't be drawn. use a bigger atlas in setup().");
+    }
+    glyphsPending.swap(glyphsPacked);
+    drawGlyphs();
+}
+
+void ofxScrollViewLabelLayer::drawGlyphs() {
+    atlas.begin();
+    ofPushStyle();
+    ofSetColor(255);
+    for(int i=0; i<glyphsPending.size(); i++) {
+        ofxScrollViewLabelGlyph & glyph = glyphs[glyphsPending[i]];
+        float x = glyph.atlasRect.x - glyph.textRect.x;
+        float y = glyph.atlasRect.y - glyph.textRect.y;
+        if(font != NULL) {
+            font->drawString(glyphsPending[i], x, y);
+        } else {
+            ofDrawBitmapString(glyphsPending[i], x, y);
+        }
+        glyph.bRasterized = true;
+    }
+    ofPopStyle();
+    atlas.end();
+    
+    glyphsPending.clear();
+    bMeshDirty = true;
+}
+
+void ofxScrollViewLabelLayer::rebuildMesh(int lodLevel) {
+    // meshes are kept between rebuilds so their vbos are reused.
+    for(int i=0; i<meshes.size(); i++) {
+        meshes[i].clear();
+    }
+    numOfMeshLabels = 0;
+    
+    labelIDs.clear();
+    index.getItemsInRect(ofxScrollView::toCore(meshRect), labelIDs);
+    
+    ofTexture & texture = atlas.getTextureReference();
+    for(int i=0; i<labelIDs.size(); i++) {
+        const ofxScrollViewLabel & label = labels[labelIDs[i]];
+        if(label.lodMin > lodLevel) {
+            continue;
+        }
+        const ofxScrollViewLabelGlyph & glyph = glyphs[label.text];
+        if(glyph.bRasterized == false) {
+            continue;
+        }
+        
+        // drawn under mat, relative to the render origin.
+        float x0 = label.rect.x - meshRenderOrigin.x;
+        float y0 = label.rect.y - meshRenderOrigin.y;
+        float x1 = x0 + label.rect.width;
+        float y1 = y0 + label.rect.height;
+        ofPoint t0 = texture.getCoordFromPoint(glyph.atlasRect.x, glyph.atlasRect.y);
+        ofPoint t1 = texture.getCoordFromPoint(glyph.atlasRect.x + glyph.atlasRect.width, glyph.atlasRect.y + glyph.atlasRect.height);
+        
+        int meshIndex = numOfMeshLabels / kLabelsPerMesh;
+        if(meshIndex >= meshes.size()) {
+            meshes.push_back(ofVboMesh());
+            meshes.back().setMode(OF_PRIMITIVE_TRIANGLES);
+            meshes.back().setUsage(GL_STATIC_DRAW);
+        }
+        ofVboMesh & mesh = meshes[meshIndex];
+        
+        int vertexIndex = mesh.getNumVertices();
+        mesh.addVertex(ofVec3f(x0, y0, 0));
+        mesh.addVertex(ofVec3f(x1, y0, 0));
+        mesh.addVertex(ofVec3f(x1, y1, 0));
+        mesh.addVertex(ofVec3f(x0, y1, 0));
+        mesh.addTexCoord(ofVec2f(t0.x, t0.y));
+        mesh.addTexCoord(ofVec2f(t1.x, t0.y));
+        mesh.addTexCoord(ofVec2f(t1.x, t1.y));
+        mesh.addTexCoord(ofVec2f(t0.x, t1.y));
+        mesh.addIndex(vertexIndex + 0);
+        mesh.addIndex(vertexIndex + 1);
+        mesh.addIndex(vertexIndex + 2);
+        mesh.addIndex(vertexIndex + 0);
+        mesh.addIndex(vertexIndex + 2);
+        mesh.addIndex(vertexIndex + 3);
+        
+        numOfMeshLabels += 1;
+    }
+    
+    numOfMeshRebuilds += 1;
+    bMeshDirty = false;
+}
@@ -0,0 +1,113 @@
+//
+//  ofxScrollViewLabelLayer.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollView.h"
+#include "ofxScrollViewContentIndex.h"
+#include <unordered_map>
+
+//--------------------------------------------------------------
+class ofxScrollViewLabel {
+public:
+    ofxScrollViewLabel() {
+        lodMin = 0;
+    }
+    string text;
+    ofVec2f pos;        // top left, in content.
+    ofRectangle rect;   // in content, the text size times the label scale.
+    int lodMin;         // drawn from this scroll view lod level up.
+};
+
+class ofxScrollViewLabelGlyph {
+public:
+    ofxScrollViewLabelGlyph() {
+        bRasterized = false;
+    }
+    ofRectangle textRect;   // text bounds relative to the point it's drawn from.
+    ofRectangle atlasRect;  // where it sits in the atlas, in pixels.
+    bool bRasterized;
+};
+
+//--------------------------------------------------------------
+// draws lots of text labels inside a scroll view with one draw call per kLabelsPerMesh labels.
+// every distinct string is rasterized once into a texture atlas,
+// labels are kept in a quadtree and the visible ones are batched into meshes of textured quads.
+// the meshes cover the visible content rect plus a margin and are only rebuilt when labels or text change,
+// the scroll view lod level or render origin changes, or the view moves past the margin.
+// when the atlas fills up it is cleared and repacked with only the strings still in use.
+// draw() between scrollView.begin() and end(), or inside drawContent().
+//--------------------------------------------------------------
+class ofxScrollViewLabelLayer {
+
+public:
+    
+    ofxScrollViewLabelLayer();
+    ~ofxScrollViewLabelLayer();
+    
+    void setup(const ofRectangle & contentRect, int atlasWidth=1024, int atlasHeight=1024);
+    void clear();
+    
+    void setFont(ofTrueTypeFont * font);    // NULL uses the bitmap font, set before adding labels.
+    void setLabelScale(float value);        // content units per label pixel, default 1.
+    void setCullMargin(float value);        // screen pixels built around the window, default 256.
+    void setColor(const ofColor & value);
+    
+    void addLabel(int labelID, const string & text, const ofVec2f & pos, int lodMin=0);
+    void setLabelText(int labelID, const string & text);
+    void moveLabel(int labelID, const ofVec2f & pos);
+    void removeLabel(int labelID);
+    bool hasLabel(int labelID);
+    
+    void update(ofxScrollView & scrollView);
+    void draw();
+    
+    int getNumOfLabels();
+    int getNumOfVisibleLabels();    // in the mesh.
+    int getNumOfGlyphs();           // distinct strings in the atlas.
+    int getNumOfMeshRebuilds();
+    
+    static const int kLabelsPerMesh = 16384;    // 65536 vertices, all a 16 bit index can reach.
+    
+    ofFbo atlas;
+    vector<ofVboMesh> meshes;
+
+protected:
+    
+    ofxScrollViewLabelGlyph & getGlyph(const string & text);
+    ofRectangle getTextRect(const string & text);
+    ofRectangle getLabelRect(const ofVec2f & pos, const ofxScrollViewLabelGlyph & glyph);
+    bool packGlyph(ofxScrollViewLabelGlyph & glyph);
+    void rasterizeGlyphs();
+    void repackAtlas();
+    void drawGlyphs();      // the pending glyphs, already packed.
+    void rebuildMesh(int lodLevel);
+    
+    ofTrueTypeFont * font;
+    float labelScale;
+    float cullMargin;
+    ofColor color;
+    
+    int atlasWidth;
+    int atlasHeight;
+    int atlasX;                 // shelf packing, next free spot on the current shelf.
+    int atlasY;
+    int atlasShelfHeight;
+    
+    std::unordered_map<int, ofxScrollViewLabel> labels;
+    std::unordered_map<string, ofxScrollViewLabelGlyph> glyphs;
+    vector<string> glyphsPending;
+    ofxScrollViewContentIndex index;
+    vector<int> labelIDs;
+    
+    ofRectangle meshRect;       // content covered by the mesh.
+    ofVec2f meshRenderOrigin;
+    int meshLodLevel;
+    int numOfMeshLabels;
+    int numOfMeshRebuilds;
+    bool bMeshDirty;
+};
@@ -0,0 +1,259 @@
+//
+//  ofxScrollViewList.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewList.h"
+#include <cmath>
+
+//--------------------------------------------------------------
+ofxScrollViewList::ofxScrollViewList() {
+    view = NULL;
+    dataSource = NULL;
+    
+    numOfRows = 0;
+    numOfColumns = 1;
+    rowHeight = 0;
+    bVariableRowHeights = false;
+    
+    anchorRow = -1;
+    anchorY = 0;
+    
+    rowFirst = 0;
+    rowLast = -1;
+}
+
+ofxScrollViewList::~ofxScrollViewList() {
+    for(int i=0; i<cellsVisible.size(); i++) {
+        delete cellsVisible[i];
+    }
+    for(int i=0; i<cellsPool.size(); i++) {
+        delete cellsPool[i];
+    }
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewList::setup(ofxScrollViewCore * viewPtr, ofxScrollViewListDataSource * dataSourcePtr) {
+    view = viewPtr;
+    dataSource = dataSourcePtr;
+    
+    reloadData();
+}
+
+void ofxScrollViewList::reloadData() {
+    if(view == NULL || dataSource == NULL) {
+        return;
+    }
+    
+    numOfRows = dataSource->getNumOfRows();
+    numOfColumns = dataSource->getNumOfColumns();
+    numOfRows = (numOfRows < 0) ? 0 : numOfRows;
+    numOfColumns = (numOfColumns < 1) ? 1 : numOfColumns;
+    
+    bVariableRowHeights = dataSource->hasVariableRowHeights();
+    rowHeight = 0;
+    if(numOfRows > 0) {
+        rowHeight = bVariableRowHeights ? dataSource->getEstimatedRowHeight() : dataSource->getRowHeight(0);
+    }
+    
+    anchorRow = -1;
+    anchorY = 0;
+    
+    for(int i=0; i<cellsVisible.size(); i++) {
+        cellsPool.push_back(cellsVisible[i]);
+    }
+    cellsVisible.clear();
+    rowFirst = 0;
+    rowLast = -1;
+    
+    const ofxScrollViewRect & windowRect = view->getWindowRect();
+    view->setContentRect(ofxScrollViewRect(0, 0, windowRect.width, numOfRows * rowHeight));
+    view->setup();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewList::update() {
+    if(view == NULL || dataSource == NULL) {
+        return;
+    }
+    
+    ofxScrollViewRect visibleRect = view->getVisibleContentRect();
+    double rowY = 0;
+    getRowRange(visibleRect, rowFirst, rowLast, rowY);
+    
+    recycleCells();
+    
+    float cellWidth = view->getContentRect().width / numOfColumns;
+    
+    for(int row=rowFirst; row<=rowLast; row++) {
+        float cellHeight = getRowHeight(row);
+        
+        for(int column=0; column<numOfColumns; column++) {
+            int cellIndex = (row - rowFirst) * numOfColumns + column;
+            ofxScrollViewListCell * cell = cellsVisible[cellIndex];
+            
+            bool bCellNew = (cell == NULL);
+            if(bCellNew == true) {
+                if(cellsPool.size() > 0) {
+                    cell = cellsPool.back();
+                    cellsPool.pop_back();
+                } else {
+                    cell = dataSource->createCell();
+                }
+                cellsVisible[cellIndex] = cell;
+            }
+            
+            cell->row = row;
+            cell->column = column;
+            cell->rect.x = column * cellWidth;
+            cell->rect.y = rowY;
+            cell->rect.width = cellWidth;
+            cell->rect.height = cellHeight;
+            
+            if(bCellNew == true) {
+                dataSource->setupCell(cell);
+            }
+        }
+        
+        rowY += cellHeight;
+    }
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewList::getRowClamped(double row) {
+    // clamped before the cast, a row past INT_MAX doesn't fit an int.
+    if(row < 0) {
+        return 0;
+    }
+    if(row > numOfRows - 1) {
+        return numOfRows - 1;
+    }
+    return (int)row;
+}
+
+void ofxScrollViewList::getRowRange(const ofxScrollViewRect & rect, int & row0, int & row1, double & row0Y) {
+    row0 = 0;
+    row1 = -1;
+    row0Y = 0;
+    
+    if(numOfRows == 0 || rowHeight <= 0 || rect.isEmpty() == true) {
+        return;
+    }
+    
+    double yTop = rect.y;
+    double yBottom = (double)rect.y + rect.height;
+    
+    if(bVariableRowHeights == false) {
+        // floored in double, a float can't hold the fraction of a row index past about 8.4M rows.
+        row0 = getRowClamped(std::floor(yTop / rowHeight));
+        row1 = getRowClamped(std::floor(yBottom / rowHeight));
+        row1 = (row1 < row0) ? row0 : row1;
+        row0Y = (double)row0 * rowHeight;
+        return;
+    }
+    
+    //-------------------------------------------------------------- variable row heights.
+    // rows are placed from an anchor row that follows the visible rect,
+    // so small moves walk a few rows from the last frame and the rows track the drag exactly.
+    // a jump further than a couple of screens places the anchor with the estimated row height instead.
+    // the estimate drifts from the real heights, so the first row is pinned to the top of the content
+    // and the last row to the bottom when they come into view.
+    // positions are summed in doubles, a float stops moving when adding a row height deep into a long list.
+    
+    bool bFar = (anchorRow < 0) || (fabs(anchorY - yTop) > rect.height * 2);
+    if(bFar == true) {
+        anchorRow = getRowClamped(std::floor(yTop / rowHeight));
+        anchorY = (double)anchorRow * rowHeight;
+    }
+    
+    while(anchorRow > 0 && anchorY > yTop) {
+        anchorRow -= 1;
+        anchorY -= getRowHeight(anchorRow);
+    }
+    while(anchorRow < numOfRows - 1 && anchorY + getRowHeight(anchorRow) <= yTop) {
+        anchorY += getRowHeight(anchorRow);
+        anchorRow += 1;
+    }
+    if(anchorRow == 0) {
+        anchorY = 0;
+    }
+    
+    int row = anchorRow;
+    double y = anchorY;
+    while(row < numOfRows && y < yBottom) {
+        y += getRowHeight(row);
+        row += 1;
+    }
+    
+    double contentHeight = view->getContentRect().height;
+    if(row == numOfRows && anchorRow > 0 && y != contentHeight) {
+        y = contentHeight;
+        row = numOfRows;
+        while(row > 0 && y > yTop) {
+            row -= 1;
+            y -= getRowHeight(row);
+        }
+        anchorRow = row;
+        anchorY = (row == 0) ? 0 : y;
+        
+        row = anchorRow;
+        y = anchorY;
+        while(row < numOfRows && y < yBottom) {
+            y += getRowHeight(row);
+            row += 1;
+        }
+    }
+    
+    row0 = anchorRow;
+    row1 = (row - 1 < row0) ? row0 : row - 1;
+    row0Y = anchorY;
+}
+
+float ofxScrollViewList::getRowHeight(int row) {
+    if(bVariableRowHeights == false) {
+        return rowHeight;
+    }
+    return dataSource->getRowHeight(row);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewList::recycleCells() {
+    
+    int numOfCells = (rowLast - rowFirst + 1) * numOfColumns;
+    numOfCells = (numOfCells < 0) ? 0 : numOfCells;
+    cellsSlots.assign(numOfCells, NULL);
+    
+    // cells still on screen keep their row, the rest go back to the pool.
+    for(int i=0; i<cellsVisible.size(); i++) {
+        ofxScrollViewListCell * cell = cellsVisible[i];
+        bool bKeep = true;
+        bKeep = bKeep && (cell->row >= rowFirst);
+        bKeep = bKeep && (cell->row <= rowLast);
+        bKeep = bKeep && (cell->column < numOfColumns);
+        if(bKeep == true) {
+            cellsSlots[(cell->row - rowFirst) * numOfColumns + cell->column] = cell;
+        } else {
+            cellsPool.push_back(cell);
+        }
+    }
+    
+    cellsVisible.swap(cellsSlots);
+}
+
+//--------------------------------------------------------------
+const std::vector<ofxScrollViewListCell *> & ofxScrollViewList::getVisibleCells() {
+    return cellsVisible;
+}
+
+int ofxScrollViewList::getFirstVisibleRow() {
+    return rowFirst;
+}
+
+int ofxScrollViewList::getLastVisibleRow() {
+    return rowLast;
+}
+
+int ofxScrollViewList::getNumOfCells() {
+    return cellsVisible.size() + cellsPool.size();
+}
@@ -0,0 +1,96 @@
+//
+//  ofxScrollViewList.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  virtualized list / grid laid out inside a scroll view.
+//  only the rows inside the visible content rect get a cell,
+//  cells that scroll out of view go back to a pool and are reused for the rows scrolling in,
+//  so the cost of update() depends on the rows on screen and not on the number of rows.
+//
+
+#pragma once
+
+#include "ofxScrollViewCore.h"
+
+//--------------------------------------------------------------
+class ofxScrollViewListCell {
+public:
+    ofxScrollViewListCell() {
+        row = -1;
+        column = -1;
+    }
+    virtual ~ofxScrollViewListCell() {
+        //
+    }
+    int row;
+    int column;
+    ofxScrollViewRect rect;     // in content space.
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewListDataSource {
+public:
+    virtual ~ofxScrollViewListDataSource() {
+        //
+    }
+    
+    virtual int getNumOfRows() = 0;
+    virtual int getNumOfColumns() { return 1; }
+    
+    // when row heights do not vary, getRowHeight(0) is used for every row.
+    // when they do, getRowHeight() is only asked for the rows near the visible rect
+    // and the rest of the list is sized with getEstimatedRowHeight().
+    virtual float getRowHeight(int row) = 0;
+    virtual bool hasVariableRowHeights() { return false; }
+    virtual float getEstimatedRowHeight() { return getRowHeight(0); }
+    
+    // subclass ofxScrollViewListCell to hold per cell objects, eg. a label or a loaded image.
+    // setupCell() is called every time a cell is given a new row / column.
+    virtual ofxScrollViewListCell * createCell() { return new ofxScrollViewListCell(); }
+    virtual void setupCell(ofxScrollViewListCell *) {}
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewList {
+
+public:
+    
+    ofxScrollViewList();
+    virtual ~ofxScrollViewList();
+    
+    // the window rect of the view must be set first.
+    void setup(ofxScrollViewCore * view, ofxScrollViewListDataSource * dataSource);
+    void reloadData(); // reads the row count again, sizes the content rect and scrolls back to the top.
+    
+    void update(); // call after the view has updated.
+    
+    const std::vector<ofxScrollViewListCell *> & getVisibleCells();
+    int getFirstVisibleRow();
+    int getLastVisibleRow();
+    int getNumOfCells(); // visible and pooled.
+
+protected:
+    
+    int getRowClamped(double row);
+    void getRowRange(const ofxScrollViewRect & rect, int & row0, int & row1, double & row0Y);
+    float getRowHeight(int row);
+    void recycleCells();
+    
+    ofxScrollViewCore * view;
+    ofxScrollViewListDataSource * dataSource;
+    
+    int numOfRows;
+    int numOfColumns;
+    float rowHeight;
+    bool bVariableRowHeights;
+    
+    int anchorRow;          // variable heights, top of anchorRow sits at anchorY in content space.
+    double anchorY;
+    
+    int rowFirst;
+    int rowLast;
+    std::vector<ofxScrollViewListCell *> cellsVisible;
+    std::vector<ofxScrollViewListCell *> cellsPool;
+    std::vector<ofxScrollViewListCell *> cellsSlots;
+};
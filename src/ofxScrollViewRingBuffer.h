@@ -0,0 +1,88 @@
+//
+//  ofxScrollViewRingBuffer.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+//--------------------------------------------------------------
+// lock free single producer / single consumer ring buffer.
+// push() must only be called from one thread and pop() from one other thread.
+// setup() is not thread safe and must be called before either thread starts using it.
+//--------------------------------------------------------------
+template<typename T>
+class ofxScrollViewRingBuffer {
+    
+public:
+    
+    ofxScrollViewRingBuffer(size_t capacity=64) {
+        setup(capacity);
+    }
+    
+    void setup(size_t capacity) {
+        size_t size = 1;
+        while(size < capacity + 1) {
+            size <<= 1; // power of two so indices wrap with a mask.
+        }
+        items.clear();
+        items.resize(size);
+        mask = size - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+    
+    bool push(const T & item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t hNext = (h + 1) & mask;
+        if(hNext == tail.load(std::memory_order_acquire)) {
+            return false; // full.
+        }
+        items[h] = item;
+        head.store(hNext, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T & item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if(t == head.load(std::memory_order_acquire)) {
+            return false; // empty.
+        }
+        item = items[t];
+        tail.store((t + 1) & mask, std::memory_order_release);
+        return true;
+    }
+    
+    bool peek(T & item) const { // consumer side, like pop() without removing.
+        size_t t = tail.load(std::memory_order_relaxed);
+        if(t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[t];
+        return true;
+    }
+    
+    bool isEmpty() const {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+    
+    size_t size() const {
+        size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_acquire);
+        return (h - t) & mask;
+    }
+    
+    size_t capacity() const {
+        return mask;
+    }
+    
+private:
+    
+    std::vector<T> items;
+    size_t mask;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+};
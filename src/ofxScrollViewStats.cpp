@@ -0,0 +1,222 @@
+//
+//  ofxScrollViewStats.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewStats.h"
+#include <cstdio>
+#include <fstream>
+
+//--------------------------------------------------------------
+static const char * const kPhaseNames[OFX_SCROLL_VIEW_NUM_OF_PHASES] = {
+    "update",
+    "animation",
+    "drag",
+    "zoom",
+    "containment",
+    "easing",
+    "matrix",
+    "draw"
+};
+
+static const char * const kStateNames[OFX_SCROLL_VIEW_NUM_OF_STATES] = {
+    "idle",
+    "dragging",
+    "zooming",
+    "animating",
+    "easing"
+};
+
+//--------------------------------------------------------------
+ofxScrollViewStats::ofxScrollViewStats() {
+    bEnabled = false;
+    bTracing = false;
+    traceEventsMax = 0;
+    traceTimeStart = 0;
+    
+    reset();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewStats::setEnabled(bool bEnable) {
+    bEnabled = bEnable;
+}
+
+void ofxScrollViewStats::reset() {
+    for(int i=0; i<OFX_SCROLL_VIEW_NUM_OF_PHASES; i++) {
+        phaseTimeStart[i] = 0;
+        phaseTimeTotal[i] = 0;
+        phaseTimeMax[i] = 0;
+    }
+    for(int i=0; i<OFX_SCROLL_VIEW_NUM_OF_STATES; i++) {
+        stateFrames[i] = 0;
+    }
+    numOfFrames = 0;
+    stateLast = OFX_SCROLL_VIEW_STATE_IDLE;
+    
+    bSettling = false;
+    settleFrames = 0;
+    settleFramesLast = -1;
+    settleFramesMax = 0;
+    settleFramesTotal = 0;
+    numOfSettles = 0;
+}
+
+//--------------------------------------------------------------
+double ofxScrollViewStats::getTimeInMicros() {
+    static std::chrono::steady_clock::time_point const timeStart = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - timeStart;
+    return time.count();
+}
+
+void ofxScrollViewStats::endPhase(ofxScrollViewPhase phase, double timeEnd) {
+    double duration = timeEnd - phaseTimeStart[phase];
+    phaseTimeTotal[phase] += duration;
+    if(duration > phaseTimeMax[phase]) {
+        phaseTimeMax[phase] = duration;
+    }
+    
+    if(bTracing == false || traceEvents.size() >= traceEventsMax) {
+        return;
+    }
+    ofxScrollViewTraceEvent event;
+    event.timeStart = phaseTimeStart[phase] - traceTimeStart;
+    event.duration = duration;
+    event.phase = phase;
+    event.state = stateLast;
+    traceEvents.push_back(event);
+}
+
+void ofxScrollViewStats::endFrame(ofxScrollViewState state, bool bSettled) {
+    if(bEnabled == false) {
+        return;
+    }
+    
+    numOfFrames += 1;
+    stateFrames[state] += 1;
+    
+    // counting starts on the first frame after letting go of a drag or pinch.
+    bool bTouchingLast = (stateLast == OFX_SCROLL_VIEW_STATE_DRAGGING) || (stateLast == OFX_SCROLL_VIEW_STATE_ZOOMING);
+    bool bTouching = (state == OFX_SCROLL_VIEW_STATE_DRAGGING) || (state == OFX_SCROLL_VIEW_STATE_ZOOMING);
+    if(bTouchingLast == true && bTouching == false) {
+        bSettling = true;
+        settleFrames = 0;
+    } else if(bTouching == true) {
+        bSettling = false;
+    }
+    
+    if(bSettling == true) {
+        settleFrames += 1;
+        if(bSettled == true) {
+            bSettling = false;
+            settleFramesLast = settleFrames;
+            settleFramesTotal += settleFrames;
+            numOfSettles += 1;
+            if(settleFrames > settleFramesMax) {
+                settleFramesMax = settleFrames;
+            }
+        }
+    }
+    
+    stateLast = state;
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewStats::getNumOfFrames() {
+    return numOfFrames;
+}
+
+double ofxScrollViewStats::getPhaseTimeTotal(ofxScrollViewPhase phase) {
+    return phaseTimeTotal[phase];
+}
+
+double ofxScrollViewStats::getPhaseTimeAverage(ofxScrollViewPhase phase) {
+    if(numOfFrames == 0) {
+        return 0;
+    }
+    return phaseTimeTotal[phase] / numOfFrames;
+}
+
+double ofxScrollViewStats::getPhaseTimeMax(ofxScrollViewPhase phase) {
+    return phaseTimeMax[phase];
+}
+
+int ofxScrollViewStats::getNumOfFramesInState(ofxScrollViewState state) {
+    return stateFrames[state];
+}
+
+int ofxScrollViewStats::getFramesToSettleLast() {
+    return settleFramesLast;
+}
+
+double ofxScrollViewStats::getFramesToSettleAverage() {
+    if(numOfSettles == 0) {
+        return 0;
+    }
+    return settleFramesTotal / (double)numOfSettles;
+}
+
+int ofxScrollViewStats::getFramesToSettleMax() {
+    return settleFramesMax;
+}
+
+const char * ofxScrollViewStats::getPhaseName(ofxScrollViewPhase phase) {
+    return kPhaseNames[phase];
+}
+
+const char * ofxScrollViewStats::getStateName(ofxScrollViewState state) {
+    return kStateNames[state];
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewStats::startTrace(int maxNumOfEvents) {
+    traceEvents.clear();
+    traceEventsMax = maxNumOfEvents;
+    traceEvents.reserve(traceEventsMax); // no allocations while tracing.
+    traceTimeStart = getTimeInMicros();
+    bTracing = true;
+}
+
+void ofxScrollViewStats::stopTrace() {
+    bTracing = false;
+}
+
+bool ofxScrollViewStats::isTracing() {
+    return bTracing;
+}
+
+const std::vector<ofxScrollViewTraceEvent> & ofxScrollViewStats::getTraceEvents() {
+    return traceEvents;
+}
+
+std::string ofxScrollViewStats::getTraceJson() {
+    
+    // chrome trace event format, one complete ("X") event per timed phase.
+    // nested phases show up stacked under update.
+    
+    std::string json = "{\"traceEvents\":[\n";
+    char line[256];
+    for(int i=0; i<traceEvents.size(); i++) {
+        const ofxScrollViewTraceEvent & event = traceEvents[i];
+        snprintf(line, sizeof(line),
+                 "{\"name\":\"%s\",\"cat\":\"ofxScrollView\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,\"args\":{\"state\":\"%s\"}}%s\n",
+                 kPhaseNames[event.phase],
+                 event.timeStart,
+                 event.duration,
+                 kStateNames[event.state],
+                 (i < traceEvents.size() - 1) ? "," : "");
+        json += line;
+    }
+    json += "],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool ofxScrollViewStats::saveTrace(const std::string & path) {
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+    if(file.is_open() == false) {
+        return false;
+    }
+    file << getTraceJson();
+    return file.good();
+}
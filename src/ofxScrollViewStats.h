@@ -0,0 +1,118 @@
+//
+//  ofxScrollViewStats.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  timings and counters for one scroll view, off by default.
+//  phases are timed with a steady wall clock, not the view clock,
+//  and can be saved as chrome trace event json to open in chrome://tracing or perfetto.
+//
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------
+enum ofxScrollViewPhase {
+    OFX_SCROLL_VIEW_PHASE_UPDATE = 0,   // all of update().
+    OFX_SCROLL_VIEW_PHASE_ANIMATION,
+    OFX_SCROLL_VIEW_PHASE_DRAG,
+    OFX_SCROLL_VIEW_PHASE_ZOOM,
+    OFX_SCROLL_VIEW_PHASE_CONTAINMENT,
+    OFX_SCROLL_VIEW_PHASE_EASING,
+    OFX_SCROLL_VIEW_PHASE_MATRIX,
+    OFX_SCROLL_VIEW_PHASE_DRAW,         // between begin() and end().
+    OFX_SCROLL_VIEW_NUM_OF_PHASES
+};
+
+enum ofxScrollViewState {
+    OFX_SCROLL_VIEW_STATE_IDLE = 0,
+    OFX_SCROLL_VIEW_STATE_DRAGGING,
+    OFX_SCROLL_VIEW_STATE_ZOOMING,
+    OFX_SCROLL_VIEW_STATE_ANIMATING,
+    OFX_SCROLL_VIEW_STATE_EASING,       // flinging or easing into place with nothing touching.
+    OFX_SCROLL_VIEW_NUM_OF_STATES
+};
+
+struct ofxScrollViewTraceEvent {
+    double timeStart;   // microseconds since the trace started.
+    double duration;
+    unsigned char phase;
+    unsigned char state;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewStats {
+
+public:
+    
+    ofxScrollViewStats();
+    
+    void setEnabled(bool bEnable);
+    bool isEnabled() { return bEnabled; }
+    void reset();
+    
+    //-------------------------------------------------------------- called by the view.
+    void beginPhase(ofxScrollViewPhase phase) {
+        if(bEnabled == false) {
+            return;
+        }
+        phaseTimeStart[phase] = getTimeInMicros();
+    }
+    void endPhase(ofxScrollViewPhase phase) {
+        if(bEnabled == false) {
+            return;
+        }
+        endPhase(phase, getTimeInMicros());
+    }
+    void endFrame(ofxScrollViewState state, bool bSettled);
+    
+    //-------------------------------------------------------------- results, times in microseconds.
+    int getNumOfFrames();
+    double getPhaseTimeTotal(ofxScrollViewPhase phase);
+    double getPhaseTimeAverage(ofxScrollViewPhase phase);   // per frame.
+    double getPhaseTimeMax(ofxScrollViewPhase phase);       // longest single run of the phase.
+    int getNumOfFramesInState(ofxScrollViewState state);
+    int getFramesToSettleLast();    // frames from letting go to settled, -1 before the first one.
+    double getFramesToSettleAverage();
+    int getFramesToSettleMax();
+    
+    static const char * getPhaseName(ofxScrollViewPhase phase);
+    static const char * getStateName(ofxScrollViewState state);
+    
+    //-------------------------------------------------------------- chrome trace events.
+    void startTrace(int maxNumOfEvents=100000); // stops adding events once full.
+    void stopTrace();
+    bool isTracing();
+    const std::vector<ofxScrollViewTraceEvent> & getTraceEvents();
+    std::string getTraceJson();
+    bool saveTrace(const std::string & path);
+
+protected:
+    
+    double getTimeInMicros();
+    void endPhase(ofxScrollViewPhase phase, double timeEnd);
+    
+    bool bEnabled;
+    
+    double phaseTimeStart[OFX_SCROLL_VIEW_NUM_OF_PHASES];
+    double phaseTimeTotal[OFX_SCROLL_VIEW_NUM_OF_PHASES];
+    double phaseTimeMax[OFX_SCROLL_VIEW_NUM_OF_PHASES];
+    int stateFrames[OFX_SCROLL_VIEW_NUM_OF_STATES];
+    int numOfFrames;
+    ofxScrollViewState stateLast;
+    
+    bool bSettling;
+    int settleFrames;
+    int settleFramesLast;
+    int settleFramesMax;
+    int settleFramesTotal;
+    int numOfSettles;
+    
+    bool bTracing;
+    int traceEventsMax;
+    double traceTimeStart;
+    std::vector<ofxScrollViewTraceEvent> traceEvents;
+};
@@ -0,0 +1,247 @@
+//
+//  ofxScrollViewTileArchive.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTileArchive.h"
+#include <climits>
+
+#ifndef TARGET_WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//--------------------------------------------------------------
+static char const kArchiveMagic[4] = {'O', 'S', 'V', 'T'};
+static uint32_t const kArchiveVersion = 1;
+static uint32_t const kArchiveSizeMax = INT_MAX / 2; // keeps the level size rounding in getLevelWidth() inside an int.
+
+//--------------------------------------------------------------
+ofxScrollViewTileArchive::ofxScrollViewTileArchive() {
+    memset(&header, 0, sizeof(header));
+    entries = NULL;
+    fileData = NULL;
+    fileSize = 0;
+}
+
+ofxScrollViewTileArchive::~ofxScrollViewTileArchive() {
+    close();
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewTileArchive::write(const string & path,
+                                     ofxScrollViewTileSource & source,
+                                     ofImageFormat format,
+                                     ofImageQualityType quality) {
+    
+    ofstream file(ofToDataPath(path).c_str(), ios::out | ios::binary | ios::trunc);
+    if(file.is_open() == false) {
+        ofLogError("ofxScrollViewTileArchive", "write(): couldn't open " + path);
+        return false;
+    }
+    
+    ofxScrollViewTileArchiveHeader archiveHeader;
+    memset(&archiveHeader, 0, sizeof(archiveHeader));
+    memcpy(archiveHeader.magic, kArchiveMagic, sizeof(kArchiveMagic));
+    archiveHeader.version = kArchiveVersion;
+    archiveHeader.width = source.getWidth();
+    archiveHeader.height = source.getHeight();
+    archiveHeader.tileSize = source.getTileSize();
+    archiveHeader.numLevels = source.getNumLevels();
+    archiveHeader.imageFormat = format;
+    
+    int numOfTiles = 0;
+    for(int level=0; level<source.getNumLevels(); level++) {
+        numOfTiles += source.getNumCols(level) * source.getNumRows(level);
+    }
+    
+    // the index is written once all tile offsets are known.
+    vector<ofxScrollViewTileArchiveEntry> archiveEntries(numOfTiles);
+    uint64_t offset = sizeof(archiveHeader) + sizeof(ofxScrollViewTileArchiveEntry) * numOfTiles;
+    
+    file.write((const char *)&archiveHeader, sizeof(archiveHeader));
+    file.seekp(offset);
+    
+    ofPixels pixels;
+    ofBuffer buffer;
+    int entryIndex = 0;
+    
+    for(int level=0; level<source.getNumLevels(); level++) {
+        for(int row=0; row<source.getNumRows(level); row++) {
+            for(int col=0; col<source.getNumCols(level); col++) {
+                ofxScrollViewTileArchiveEntry & entry = archiveEntries[entryIndex++];
+                entry.offset = offset;
+                entry.size = 0;
+                
+                bool bLoaded = source.loadTile(ofxScrollViewTileID(level, col, row), pixels);
+                if(bLoaded == false) {
+                    continue; // empty entry, loadTile() will fail for it.
+                }
+                
+                ofSaveImage(pixels, buffer, format, quality);
+                file.write(buffer.getBinaryBuffer(), buffer.size());
+                
+                entry.size = buffer.size();
+                offset += buffer.size();
+            }
+        }
+    }
+    
+    file.seekp(sizeof(archiveHeader));
+    file.write((const char *)&archiveEntries[0], sizeof(ofxScrollViewTileArchiveEntry) * numOfTiles);
+    
+    bool bGood = file.good();
+    file.close();
+    
+    if(bGood == false) {
+        ofLogError("ofxScrollViewTileArchive", "write(): failed writing " + path);
+    }
+    
+    return bGood;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewTileArchive::open(const string & path) {
+    close();
+    
+    string filePath = ofToDataPath(path);
+    
+#ifndef TARGET_WIN32
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if(fd < 0) {
+        ofLogError("ofxScrollViewTileArchive", "open(): couldn't open " + path);
+        return false;
+    }
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(fd);
+        ofLogError("ofxScrollViewTileArchive", "open(): couldn't stat " + path);
+        return false;
+    }
+    void * data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping stays valid after the file is closed.
+    if(data == MAP_FAILED) {
+        ofLogError("ofxScrollViewTileArchive", "open(): couldn't mmap " + path);
+        return false;
+    }
+    fileData = (const char *)data;
+    fileSize = fileStat.st_size;
+#else
+    fileBuffer = ofBufferFromFile(filePath, true);
+    fileData = fileBuffer.getBinaryBuffer();
+    fileSize = fileBuffer.size();
+#endif
+    
+    //---------------------------------------------------------- validate.
+    bool bValid = (fileSize >= sizeof(header));
+    if(bValid == true) {
+        memcpy(&header, fileData, sizeof(header));
+        bValid = bValid && (memcmp(header.magic, kArchiveMagic, sizeof(kArchiveMagic)) == 0);
+        bValid = bValid && (header.version == kArchiveVersion);
+        bValid = bValid && (header.width <= kArchiveSizeMax);
+        bValid = bValid && (header.height <= kArchiveSizeMax);
+        bValid = bValid && (header.tileSize > 0);
+        bValid = bValid && (header.tileSize <= kArchiveSizeMax);
+        bValid = bValid && (header.numLevels > 0);
+    }
+    if(bValid == true) {
+        // more levels than the size allows would shift past the width of an int in getLevelWidth().
+        int numLevelsMax = getNumLevelsForSize(header.width, header.height, header.tileSize);
+        bValid = (header.numLevels <= (uint32_t)numLevelsMax);
+    }
+    
+    uint64_t numOfTiles = 0;
+    if(bValid == true) {
+        for(int level=0; level<header.numLevels; level++) {
+            levelEntryStart.push_back(numOfTiles);
+            numOfTiles += (uint64_t)getNumCols(level) * (uint64_t)getNumRows(level);
+        }
+        // divide rather than multiply so a huge tile count can't wrap the size check.
+        uint64_t numOfEntriesMax = (fileSize - sizeof(header)) / sizeof(ofxScrollViewTileArchiveEntry);
+        bValid = (numOfTiles <= numOfEntriesMax);
+    }
+    
+    if(bValid == false) {
+        ofLogError("ofxScrollViewTileArchive", "open(): " + path + " is not a valid tile archive");
+        close();
+        return false;
+    }
+    
+    entries = (const ofxScrollViewTileArchiveEntry *)(fileData + sizeof(header));
+    
+    return true;
+}
+
+void ofxScrollViewTileArchive::close() {
+#ifndef TARGET_WIN32
+    if(fileData != NULL) {
+        munmap((void *)fileData, fileSize);
+    }
+#else
+    fileBuffer.clear();
+#endif
+    
+    memset(&header, 0, sizeof(header));
+    entries = NULL;
+    levelEntryStart.clear();
+    fileData = NULL;
+    fileSize = 0;
+}
+
+bool ofxScrollViewTileArchive::isOpen() {
+    return (entries != NULL);
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewTileArchive::getWidth() {
+    return header.width;
+}
+
+int ofxScrollViewTileArchive::getHeight() {
+    return header.height;
+}
+
+int ofxScrollViewTileArchive::getTileSize() {
+    return header.tileSize;
+}
+
+int ofxScrollViewTileArchive::getNumLevels() {
+    return header.numLevels;
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewTileArchive::getTileData(const ofxScrollViewTileID & tileID, const char *& data, size_t & size) {
+    if(isOpen() == false || isTileValid(tileID) == false) {
+        return false;
+    }
+    
+    uint64_t entryIndex = levelEntryStart[tileID.level] + (uint64_t)tileID.row * getNumCols(tileID.level) + tileID.col;
+    const ofxScrollViewTileArchiveEntry & entry = entries[entryIndex];
+    
+    bool bValid = true;
+    bValid = bValid && (entry.size > 0);
+    bValid = bValid && (entry.offset <= fileSize);
+    bValid = bValid && (entry.size <= fileSize - entry.offset); // offset + size could wrap.
+    if(bValid == false) {
+        return false;
+    }
+    
+    data = fileData + entry.offset;
+    size = entry.size;
+    
+    return true;
+}
+
+bool ofxScrollViewTileArchive::loadTile(const ofxScrollViewTileID & tileID, ofPixels & pixels) {
+    const char * data = NULL;
+    size_t size = 0;
+    if(getTileData(tileID, data, size) == false) {
+        return false;
+    }
+    
+    ofBuffer buffer(data, size);
+    return ofLoadImage(pixels, buffer);
+}
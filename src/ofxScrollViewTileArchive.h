@@ -0,0 +1,69 @@
+//
+//  ofxScrollViewTileArchive.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollViewTileSource.h"
+
+//--------------------------------------------------------------
+// single file tile archive, memory mapped on open so tile lookups are a pointer into the file.
+//
+// layout, all values little endian:
+//  header      ofxScrollViewTileArchiveHeader.
+//  index       one ofxScrollViewTileArchiveEntry per tile,
+//              ordered by level, then row, then col.
+//  tile data   encoded tile images (jpeg or png) packed back to back.
+//--------------------------------------------------------------
+struct ofxScrollViewTileArchiveHeader {
+    char magic[4];          // "OSVT"
+    uint32_t version;
+    uint32_t width;         // level 0 size in pixels.
+    uint32_t height;
+    uint32_t tileSize;
+    uint32_t numLevels;
+    uint32_t imageFormat;   // ofImageFormat the tiles are encoded with.
+    uint32_t reserved;
+};
+
+struct ofxScrollViewTileArchiveEntry {
+    uint64_t offset;        // from the start of the file.
+    uint64_t size;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewTileArchive : public ofxScrollViewTileSource {
+    
+public:
+    
+    ofxScrollViewTileArchive();
+    ~ofxScrollViewTileArchive();
+    
+    static bool write(const string & path,
+                      ofxScrollViewTileSource & source,
+                      ofImageFormat format=OF_IMAGE_FORMAT_JPEG,
+                      ofImageQualityType quality=OF_IMAGE_QUALITY_HIGH);
+    
+    bool open(const string & path);
+    void close();
+    bool isOpen();
+    
+    int getWidth();
+    int getHeight();
+    int getTileSize();
+    int getNumLevels();
+    
+    bool getTileData(const ofxScrollViewTileID & tileID, const char *& data, size_t & size);
+    bool loadTile(const ofxScrollViewTileID & tileID, ofPixels & pixels);
+    
+    ofxScrollViewTileArchiveHeader header;
+    const ofxScrollViewTileArchiveEntry * entries;
+    vector<uint64_t> levelEntryStart;
+    
+    const char * fileData;
+    size_t fileSize;
+    ofBuffer fileBuffer; // used instead of mmap where it isn't available.
+};
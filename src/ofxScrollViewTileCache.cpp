@@ -0,0 +1,325 @@
+//
+//  ofxScrollViewTileCache.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTileCache.h"
+
+//--------------------------------------------------------------
+typedef pair<float, ofxScrollViewTileID> ofxScrollViewTileScore;
+
+static bool sortScoresDescending(const ofxScrollViewTileScore & a, const ofxScrollViewTileScore & b) {
+    return a.first > b.first;
+}
+
+//--------------------------------------------------------------
+ofxScrollViewTileCache::ofxScrollViewTileCache() {
+    textureBytes = 0;
+    textureBytesInUse = 0;
+    pixelsBytes = 0;
+    textureBudget = 64 * 1024 * 1024;
+    pixelsBudget = 0;
+    
+    evictionWeightAge = 1.0;
+    evictionWeightDistance = 10.0;
+    evictionWeightLevel = 10.0;
+    
+    focusLevel = 0;
+    frameNum = 0;
+}
+
+ofxScrollViewTileCache::~ofxScrollViewTileCache() {
+    clear();
+}
+
+void ofxScrollViewTileCache::setup(int numOfLevels) {
+    clear();
+    stats.clear();
+    stats.resize(MAX(numOfLevels, 1));
+}
+
+void ofxScrollViewTileCache::clear() {
+    entries.clear();
+    rejectedTiles.clear();
+    textureBytes = 0;
+    textureBytesInUse = 0;
+    pixelsBytes = 0;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileCache::setTextureBudgetInBytes(size_t value) {
+    textureBudget = value;
+    rejectedTiles.clear(); // worth another try.
+}
+
+void ofxScrollViewTileCache::setPixelsBudgetInBytes(size_t value) {
+    pixelsBudget = value;
+}
+
+void ofxScrollViewTileCache::setEvictionWeights(float age, float distance, float level) {
+    evictionWeightAge = age;
+    evictionWeightDistance = distance;
+    evictionWeightLevel = level;
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileCache::beginFrame(const ofRectangle & rect, int level) {
+    focusRect = rect;
+    focusLevel = level;
+    
+    textureBytesInUse = 0;
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it) {
+        if(it->second.frameLastUsed == frameNum) {
+            textureBytesInUse += it->second.textureBytes;
+        }
+    }
+    
+    frameNum += 1;
+    
+    // budgets may have been lowered since the last frame.
+    evictTextures(0);
+    evictPixels(0);
+    removeEmptyEntries();
+    
+    // a rejected tile can be tried again once the tiles that kept it out are no longer all in use.
+    map<ofxScrollViewTileID, size_t>::iterator itRejected = rejectedTiles.begin();
+    while(itRejected != rejectedTiles.end()) {
+        if(textureBytesInUse + itRejected->second <= textureBudget) {
+            rejectedTiles.erase(itRejected++);
+        } else {
+            ++itRejected;
+        }
+    }
+}
+
+void ofxScrollViewTileCache::touch(const ofxScrollViewTileID & tileID) {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.find(tileID);
+    if(it == entries.end()) {
+        return;
+    }
+    it->second.frameLastUsed = frameNum;
+}
+
+//--------------------------------------------------------------
+ofTexture * ofxScrollViewTileCache::getTexture(const ofxScrollViewTileID & tileID) {
+    ofTexture * texture = findTexture(tileID);
+    
+    ofxScrollViewTileCacheStats & levelStats = getStatsForLevel(tileID.level);
+    if(texture != NULL) {
+        levelStats.hits += 1;
+    } else {
+        levelStats.misses += 1;
+    }
+    
+    return texture;
+}
+
+ofTexture * ofxScrollViewTileCache::findTexture(const ofxScrollViewTileID & tileID) {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.find(tileID);
+    if(it == entries.end() || it->second.textureBytes == 0) {
+        return NULL;
+    }
+    it->second.frameLastUsed = frameNum;
+    return &it->second.texture;
+}
+
+bool ofxScrollViewTileCache::hasTexture(const ofxScrollViewTileID & tileID) {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.find(tileID);
+    return (it != entries.end()) && (it->second.textureBytes > 0);
+}
+
+bool ofxScrollViewTileCache::hasPixels(const ofxScrollViewTileID & tileID) {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.find(tileID);
+    return (it != entries.end()) && (it->second.pixelsBytes > 0);
+}
+
+bool ofxScrollViewTileCache::isRejected(const ofxScrollViewTileID & tileID) {
+    return rejectedTiles.find(tileID) != rejectedTiles.end();
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewTileCache::upload(const ofxScrollViewTileID & tileID,
+                                    const ofRectangle & rect,
+                                    const ofPixels & pixels) {
+    
+    size_t bytes = pixels.getWidth() * pixels.getHeight() * pixels.getBytesPerPixel();
+    
+    ofxScrollViewTileCacheEntry & entry = entries[tileID];
+    entry.tileID = tileID;
+    entry.rect = rect;
+    entry.frameLastUsed = frameNum;
+    
+    if(entry.pixelsBytes == 0 && bytes <= pixelsBudget) {
+        if(evictPixels(bytes) == true) {
+            entry.pixels = pixels;
+            entry.pixelsBytes = bytes;
+            pixelsBytes += bytes;
+        }
+    }
+    
+    bool bFits = (entry.textureBytes == 0) && (evictTextures(bytes) == true);
+    if(bFits == true) {
+        entry.texture.loadData(pixels);
+        entry.textureBytes = bytes;
+        textureBytes += bytes;
+        rejectedTiles.erase(tileID);
+    } else if(entry.textureBytes == 0) {
+        rejectedTiles[tileID] = bytes;
+        getStatsForLevel(tileID.level).rejections += 1;
+    }
+    
+    removeEmptyEntries();
+    
+    return bFits;
+}
+
+bool ofxScrollViewTileCache::reupload(const ofxScrollViewTileID & tileID) {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.find(tileID);
+    if(it == entries.end() || it->second.pixelsBytes == 0) {
+        return false;
+    }
+    if(it->second.textureBytes > 0) {
+        return true;
+    }
+    return upload(tileID, it->second.rect, it->second.pixels);
+}
+
+//--------------------------------------------------------------
+size_t ofxScrollViewTileCache::getTextureBytes() {
+    return textureBytes;
+}
+
+size_t ofxScrollViewTileCache::getPixelsBytes() {
+    return pixelsBytes;
+}
+
+size_t ofxScrollViewTileCache::getTextureBudgetInBytes() {
+    return textureBudget;
+}
+
+size_t ofxScrollViewTileCache::getPixelsBudgetInBytes() {
+    return pixelsBudget;
+}
+
+//--------------------------------------------------------------
+const ofxScrollViewTileCacheStats & ofxScrollViewTileCache::getStats(int level) {
+    return getStatsForLevel(level);
+}
+
+ofxScrollViewTileCacheStats ofxScrollViewTileCache::getStatsTotal() {
+    ofxScrollViewTileCacheStats total;
+    for(int i=0; i<stats.size(); i++) {
+        total.hits += stats[i].hits;
+        total.misses += stats[i].misses;
+        total.textureEvictions += stats[i].textureEvictions;
+        total.pixelsEvictions += stats[i].pixelsEvictions;
+        total.rejections += stats[i].rejections;
+    }
+    return total;
+}
+
+void ofxScrollViewTileCache::resetStats() {
+    for(int i=0; i<stats.size(); i++) {
+        stats[i] = ofxScrollViewTileCacheStats();
+    }
+}
+
+ofxScrollViewTileCacheStats & ofxScrollViewTileCache::getStatsForLevel(int level) {
+    if(stats.size() == 0) {
+        stats.resize(1);
+    }
+    level = ofClamp(level, 0, stats.size() - 1);
+    return stats[level];
+}
+
+//--------------------------------------------------------------
+float ofxScrollViewTileCache::getEvictionScore(const ofxScrollViewTileCacheEntry & entry) {
+    float age = frameNum - entry.frameLastUsed;
+    
+    // distance between centres, in multiples of the focus rect size.
+    float focusSize = MAX(MAX(focusRect.width, focusRect.height), 1.0);
+    float dx = (entry.rect.x + entry.rect.width * 0.5) - (focusRect.x + focusRect.width * 0.5);
+    float dy = (entry.rect.y + entry.rect.height * 0.5) - (focusRect.y + focusRect.height * 0.5);
+    float distance = sqrt(dx * dx + dy * dy) / focusSize;
+    
+    float levelDiff = ABS(entry.tileID.level - focusLevel);
+    
+    float score = 0;
+    score += age * evictionWeightAge;
+    score += distance * evictionWeightDistance;
+    score += levelDiff * evictionWeightLevel;
+    return score;
+}
+
+bool ofxScrollViewTileCache::evictTextures(size_t bytesNeeded) {
+    if(textureBytes + bytesNeeded <= textureBudget) {
+        return true;
+    }
+    
+    vector<ofxScrollViewTileScore> scores;
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it) {
+        const ofxScrollViewTileCacheEntry & entry = it->second;
+        if(entry.textureBytes == 0 || entry.frameLastUsed == frameNum) {
+            continue;
+        }
+        scores.push_back(ofxScrollViewTileScore(getEvictionScore(entry), it->first));
+    }
+    sort(scores.begin(), scores.end(), sortScoresDescending);
+    
+    for(int i=0; i<scores.size(); i++) {
+        if(textureBytes + bytesNeeded <= textureBudget) {
+            break;
+        }
+        ofxScrollViewTileCacheEntry & entry = entries[scores[i].second];
+        textureBytes -= entry.textureBytes;
+        entry.textureBytes = 0;
+        entry.texture.clear();
+        getStatsForLevel(entry.tileID.level).textureEvictions += 1;
+    }
+    
+    return (textureBytes + bytesNeeded <= textureBudget);
+}
+
+bool ofxScrollViewTileCache::evictPixels(size_t bytesNeeded) {
+    if(pixelsBytes + bytesNeeded <= pixelsBudget) {
+        return true;
+    }
+    
+    vector<ofxScrollViewTileScore> scores;
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it) {
+        const ofxScrollViewTileCacheEntry & entry = it->second;
+        if(entry.pixelsBytes == 0 || entry.frameLastUsed == frameNum) {
+            continue;
+        }
+        scores.push_back(ofxScrollViewTileScore(getEvictionScore(entry), it->first));
+    }
+    sort(scores.begin(), scores.end(), sortScoresDescending);
+    
+    for(int i=0; i<scores.size(); i++) {
+        if(pixelsBytes + bytesNeeded <= pixelsBudget) {
+            break;
+        }
+        ofxScrollViewTileCacheEntry & entry = entries[scores[i].second];
+        pixelsBytes -= entry.pixelsBytes;
+        entry.pixelsBytes = 0;
+        entry.pixels.clear();
+        getStatsForLevel(entry.tileID.level).pixelsEvictions += 1;
+    }
+    
+    return (pixelsBytes + bytesNeeded <= pixelsBudget);
+}
+
+void ofxScrollViewTileCache::removeEmptyEntries() {
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry>::iterator it = entries.begin();
+    while(it != entries.end()) {
+        if(it->second.textureBytes == 0 && it->second.pixelsBytes == 0) {
+            entries.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+//
+//  ofxScrollViewTileCache.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollViewTileSource.h"
+
+//--------------------------------------------------------------
+class ofxScrollViewTileCacheStats {
+public:
+    ofxScrollViewTileCacheStats() {
+        hits = 0;
+        misses = 0;
+        textureEvictions = 0;
+        pixelsEvictions = 0;
+        rejections = 0;
+    }
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long textureEvictions;
+    unsigned long pixelsEvictions;
+    unsigned long rejections;       // uploads that didn't fit, see isRejected().
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewTileCacheEntry {
+public:
+    ofxScrollViewTileCacheEntry() {
+        textureBytes = 0;
+        pixelsBytes = 0;
+        frameLastUsed = 0;
+    }
+    ofxScrollViewTileID tileID;
+    ofRectangle rect;
+    ofTexture texture;
+    ofPixels pixels;
+    size_t textureBytes;
+    size_t pixelsBytes;
+    unsigned long frameLastUsed;
+};
+
+//--------------------------------------------------------------
+// keeps tile textures on the gpu and optionally decoded tile pixels on the cpu,
+// each within a hard byte budget.
+// when over budget the tiles with the highest eviction score are dropped first,
+// the score grows with frames since last use, distance from the focus rect and distance from the focus level.
+// tiles used in the current frame are never evicted, a tile that can't fit is not cached.
+// a rejected tile is remembered with the bytes it needed until the textures used in the last frame
+// leave room for it, so the tile layer doesn't decode it again every frame in the meantime.
+//--------------------------------------------------------------
+class ofxScrollViewTileCache {
+    
+public:
+    
+    ofxScrollViewTileCache();
+    ~ofxScrollViewTileCache();
+    
+    void setup(int numOfLevels);
+    void clear();
+    
+    void setTextureBudgetInBytes(size_t value);
+    void setPixelsBudgetInBytes(size_t value);
+    void setEvictionWeights(float age, float distance, float level);
+    
+    void beginFrame(const ofRectangle & focusRect, int focusLevel);
+    void touch(const ofxScrollViewTileID & tileID);
+    
+    ofTexture * getTexture(const ofxScrollViewTileID & tileID);
+    ofTexture * findTexture(const ofxScrollViewTileID & tileID);
+    bool hasTexture(const ofxScrollViewTileID & tileID);
+    bool hasPixels(const ofxScrollViewTileID & tileID);
+    bool isRejected(const ofxScrollViewTileID & tileID);    // its upload didn't fit and there's still no room.
+    
+    bool upload(const ofxScrollViewTileID & tileID, const ofRectangle & rect, const ofPixels & pixels);
+    bool reupload(const ofxScrollViewTileID & tileID);
+    
+    size_t getTextureBytes();
+    size_t getPixelsBytes();
+    size_t getTextureBudgetInBytes();
+    size_t getPixelsBudgetInBytes();
+    
+    const ofxScrollViewTileCacheStats & getStats(int level);
+    ofxScrollViewTileCacheStats getStatsTotal();
+    void resetStats();
+    
+    map<ofxScrollViewTileID, ofxScrollViewTileCacheEntry> entries;
+    map<ofxScrollViewTileID, size_t> rejectedTiles;     // bytes each one needed.
+    vector<ofxScrollViewTileCacheStats> stats;
+    
+    size_t textureBytes;
+    size_t textureBytesInUse;   // held by tiles used in the last frame.
+    size_t pixelsBytes;
+    size_t textureBudget;
+    size_t pixelsBudget;
+    
+    float evictionWeightAge;
+    float evictionWeightDistance;
+    float evictionWeightLevel;
+    
+    ofRectangle focusRect;
+    int focusLevel;
+    unsigned long frameNum;
+    
+protected:
+    
+    float getEvictionScore(const ofxScrollViewTileCacheEntry & entry);
+    bool evictTextures(size_t bytesNeeded);
+    bool evictPixels(size_t bytesNeeded);
+    void removeEmptyEntries();
+    ofxScrollViewTileCacheStats & getStatsForLevel(int level);
+};
@@ -0,0 +1,286 @@
+//
+//  ofxScrollViewTileLayer.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTileLayer.h"
+
+//--------------------------------------------------------------
+static bool sortRequestsByTile(const ofxScrollViewTileRequest & a, const ofxScrollViewTileRequest & b) {
+    if(a.tileID != b.tileID) {
+        return a.tileID < b.tileID;
+    }
+    return a.priority < b.priority;
+}
+
+static bool isRequestForSameTile(const ofxScrollViewTileRequest & a, const ofxScrollViewTileRequest & b) {
+    return a.tileID == b.tileID;
+}
+
+//--------------------------------------------------------------
+ofxScrollViewTileLayer::ofxScrollViewTileLayer() {
+    source = NULL;
+    level = 0;
+    maxUploadsPerFrame = 4;
+    uploadTimeBudgetInSec = 0.004;
+    prefetchFrames = 30;
+    prefetchSteps = 3;
+}
+
+ofxScrollViewTileLayer::~ofxScrollViewTileLayer() {
+    clear();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileLayer::setup(ofxScrollViewTileSource * value, int numOfWorkers) {
+    clear();
+    source = value;
+    loader.setup(source, numOfWorkers);
+    if(source != NULL) {
+        cache.setup(source->getNumLevels());
+    }
+}
+
+void ofxScrollViewTileLayer::clear() {
+    loader.close();
+    visibleTiles.clear();
+    neededTiles.clear();
+    prefetchTiles.clear();
+    requests.clear();
+    cache.clear();
+    level = 0;
+}
+
+void ofxScrollViewTileLayer::setMaxUploadsPerFrame(int value) {
+    maxUploadsPerFrame = value;
+}
+
+void ofxScrollViewTileLayer::setUploadTimeBudgetInSec(float value) {
+    uploadTimeBudgetInSec = value;
+}
+
+void ofxScrollViewTileLayer::setPrefetch(int numOfFrames, int numOfSteps) {
+    prefetchFrames = MAX(numOfFrames, 0);
+    prefetchSteps = MAX(numOfSteps, 1);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileLayer::update(ofxScrollView & scrollView) {
+    if(source == NULL || source->getNumLevels() == 0) {
+        return;
+    }
+    
+    contentRect = scrollView.getContentRect();
+    renderOrigin = ofxScrollView::toOf(scrollView.getRenderOrigin());
+    
+    // screen pixels per level 0 source pixel.
+    float pixelScale = scrollView.getScale() * (contentRect.width / source->getWidth());
+    level = getLevelForScale(pixelScale);
+    
+    ofRectangle visibleRect = scrollView.getVisibleContentRect();
+    getTilesInContentRect(visibleRect, level, visibleTiles);
+    
+    cache.beginFrame(visibleRect, level);
+    
+    //---------------------------------------------------------- visible tiles plus their coarser fallbacks.
+    requests.clear();
+    for(int i=0; i<visibleTiles.size(); i++) {
+        ofxScrollViewTileID tileID = visibleTiles[i];
+        while(tileID.level < source->getNumLevels()) {
+            requests.push_back(ofxScrollViewTileRequest(tileID, 0));
+            tileID = tileID.getParent();
+        }
+    }
+    
+    //---------------------------------------------------------- tiles where the view is heading, at a lower priority.
+    for(int i=1; i<=prefetchSteps && prefetchFrames > 0; i++) {
+        int frames = (prefetchFrames * i) / prefetchSteps;
+        ofRectangle predictedRect = scrollView.getPredictedScrollRect(frames);
+        int predictedLevel = getLevelForScale(predictedRect.width / source->getWidth());
+        
+        getTilesInContentRect(scrollView.getPredictedVisibleContentRect(frames), predictedLevel, prefetchTiles);
+        for(int j=0; j<prefetchTiles.size(); j++) {
+            requests.push_back(ofxScrollViewTileRequest(prefetchTiles[j], i));
+        }
+    }
+    
+    // one entry per tile, keeping its highest priority.
+    sort(requests.begin(), requests.end(), sortRequestsByTile);
+    requests.erase(unique(requests.begin(), requests.end(), isRequestForSameTile), requests.end());
+    
+    neededTiles.clear();
+    for(int i=0; i<requests.size(); i++) {
+        neededTiles.push_back(requests[i].tileID);
+    }
+    
+    //---------------------------------------------------------- request tiles missing from the cache, unless they were just turned away.
+    vector<ofxScrollViewTileRequest>::iterator it = requests.begin();
+    while(it != requests.end()) {
+        cache.touch(it->tileID);
+        bool bSkip = false;
+        bSkip = bSkip || (cache.hasTexture(it->tileID) == true);
+        bSkip = bSkip || (cache.hasPixels(it->tileID) == true);
+        bSkip = bSkip || (cache.isRejected(it->tileID) == true);
+        if(bSkip == true) {
+            it = requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    loader.setRequests(requests);
+    
+    uploadLoadedTiles();
+}
+
+void ofxScrollViewTileLayer::uploadLoadedTiles() {
+    unsigned long long timeStart = ofGetElapsedTimeMicros();
+    unsigned long long timeBudget = uploadTimeBudgetInSec * 1000000;
+    int numOfUploads = 0;
+    
+    // the first upload is always allowed so a tight budget can't stall loading completely.
+    
+    //---------------------------------------------------------- tiles still decoded in cpu memory first, they skip the loader.
+    for(int i=0; i<neededTiles.size() && numOfUploads < maxUploadsPerFrame; i++) {
+        const ofxScrollViewTileID & tileID = neededTiles[i];
+        if(cache.hasTexture(tileID) == true || cache.hasPixels(tileID) == false || cache.isRejected(tileID) == true) {
+            continue;
+        }
+        if(numOfUploads > 0 && ofGetElapsedTimeMicros() - timeStart > timeBudget) {
+            return;
+        }
+        cache.reupload(tileID);
+        numOfUploads += 1;
+    }
+    
+    //---------------------------------------------------------- tiles decoded by the loader.
+    ofxScrollViewTileResult result;
+    while(numOfUploads < maxUploadsPerFrame) {
+        if(numOfUploads > 0 && ofGetElapsedTimeMicros() - timeStart > timeBudget) {
+            break;
+        }
+        if(loader.getLoaded(result) == false) {
+            break;
+        }
+        
+        bool bUpload = true;
+        bUpload = bUpload && (result.bLoaded == true);
+        bUpload = bUpload && (isTileNeeded(result.tileID) == true);
+        bUpload = bUpload && (cache.hasTexture(result.tileID) == false);
+        bUpload = bUpload && (cache.isRejected(result.tileID) == false);
+        if(bUpload == true) {
+            cache.upload(result.tileID, getTileRectInContent(result.tileID), *result.pixels);
+            numOfUploads += 1;
+        }
+        
+        loader.release(result);
+    }
+}
+
+bool ofxScrollViewTileLayer::isTileNeeded(const ofxScrollViewTileID & tileID) {
+    return binary_search(neededTiles.begin(), neededTiles.end(), tileID);
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileLayer::draw() {
+    for(int i=0; i<visibleTiles.size(); i++) {
+        drawTile(visibleTiles[i]);
+    }
+}
+
+void ofxScrollViewTileLayer::drawTile(const ofxScrollViewTileID & tileID) {
+    ofRectangle tileRect = getTileRectInContent(tileID);
+    tileRect.x -= renderOrigin.x; // drawn under mat, relative to the render origin.
+    tileRect.y -= renderOrigin.y;
+    
+    // walk up the pyramid until a loaded tile is found.
+    ofxScrollViewTileID drawID = tileID;
+    ofTexture * texturePtr = cache.getTexture(drawID);
+    while(texturePtr == NULL) {
+        drawID = drawID.getParent();
+        if(drawID.level >= source->getNumLevels()) {
+            return;
+        }
+        texturePtr = cache.findTexture(drawID);
+    }
+    
+    ofTexture & texture = *texturePtr;
+    
+    if(drawID == tileID) {
+        texture.draw(tileRect);
+        return;
+    }
+    
+    // draw only the part of the coarser tile that covers this tile.
+    ofRectangle drawRect = getTileRectInContent(drawID);
+    drawRect.x -= renderOrigin.x;
+    drawRect.y -= renderOrigin.y;
+    float sx = texture.getWidth() / drawRect.width;
+    float sy = texture.getHeight() / drawRect.height;
+    
+    texture.drawSubsection(tileRect.x,
+                           tileRect.y,
+                           tileRect.width,
+                           tileRect.height,
+                           (tileRect.x - drawRect.x) * sx,
+                           (tileRect.y - drawRect.y) * sy,
+                           tileRect.width * sx,
+                           tileRect.height * sy);
+}
+
+//--------------------------------------------------------------
+int ofxScrollViewTileLayer::getLevel() {
+    return level;
+}
+
+int ofxScrollViewTileLayer::getLevelForScale(float pixelScale) {
+    int numLevels = source->getNumLevels();
+    if(pixelScale <= 0) {
+        return numLevels - 1;
+    }
+    
+    // pick the smallest level that still has at least one pixel per screen pixel.
+    int levelForScale = (int)floor(log2(1.0 / pixelScale));
+    levelForScale = ofClamp(levelForScale, 0, numLevels - 1);
+    
+    return levelForScale;
+}
+
+//--------------------------------------------------------------
+ofRectangle ofxScrollViewTileLayer::getTileRectInContent(const ofxScrollViewTileID & tileID) {
+    ofRectangle rect = source->getTileRect(tileID);
+    float sx = contentRect.width / source->getWidth();
+    float sy = contentRect.height / source->getHeight();
+    rect.x *= sx;
+    rect.y *= sy;
+    rect.width *= sx;
+    rect.height *= sy;
+    return rect;
+}
+
+void ofxScrollViewTileLayer::getTilesInContentRect(const ofRectangle & rect,
+                                                   int tileLevel,
+                                                   vector<ofxScrollViewTileID> & tileIDs) {
+    tileIDs.clear();
+    
+    if(rect.isEmpty() == true) {
+        return;
+    }
+    
+    // content rect to level pixels.
+    float sx = source->getLevelWidth(tileLevel) / contentRect.width;
+    float sy = source->getLevelHeight(tileLevel) / contentRect.height;
+    float size = source->getTileSize();
+    
+    int col0 = MAX((int)floor(rect.x * sx / size), 0);
+    int col1 = MIN((int)ceil((rect.x + rect.width) * sx / size), source->getNumCols(tileLevel));
+    int row0 = MAX((int)floor(rect.y * sy / size), 0);
+    int row1 = MIN((int)ceil((rect.y + rect.height) * sy / size), source->getNumRows(tileLevel));
+    
+    // ordered the same as ofxScrollViewTileID::operator< so lookups can binary search.
+    for(int row=row0; row<row1; row++) {
+        for(int col=col0; col<col1; col++) {
+            tileIDs.push_back(ofxScrollViewTileID(tileLevel, col, row));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  ofxScrollViewTileLayer.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollView.h"
+#include "ofxScrollViewTileSource.h"
+#include "ofxScrollViewTileLoader.h"
+#include "ofxScrollViewTileCache.h"
+
+//--------------------------------------------------------------
+// draws a tile pyramid inside a scroll view.
+// each frame the pyramid level is picked from the scroll view scale,
+// and only the tiles that intersect the visible content rect are requested and drawn.
+// tiles are decoded on worker threads and uploaded on the main thread within a per frame budget,
+// until a tile is uploaded the nearest loaded coarser tile is drawn in its place.
+// tiles along the predicted path of a fling or zoom animation are prefetched at a lower priority.
+// uploaded tiles are kept in a byte budgeted cache, see ofxScrollViewTileCache.
+//--------------------------------------------------------------
+class ofxScrollViewTileLayer {
+    
+public:
+    
+    ofxScrollViewTileLayer();
+    ~ofxScrollViewTileLayer();
+    
+    void setup(ofxScrollViewTileSource * source, int numOfWorkers=2);
+    void clear();
+    
+    void setMaxUploadsPerFrame(int value);
+    void setUploadTimeBudgetInSec(float value);
+    void setPrefetch(int numOfFrames, int numOfSteps=3);
+    
+    void update(ofxScrollView & scrollView);
+    void draw();
+    
+    int getLevel();
+    int getLevelForScale(float pixelScale);
+    
+    ofRectangle getTileRectInContent(const ofxScrollViewTileID & tileID);
+    void getTilesInContentRect(const ofRectangle & rect,
+                               int level,
+                               vector<ofxScrollViewTileID> & tileIDs);
+    
+    ofxScrollViewTileSource * source;
+    ofxScrollViewTileLoader loader;
+    ofxScrollViewTileCache cache;
+    ofRectangle contentRect;
+    ofVec2f renderOrigin;
+    int level;
+    
+    int maxUploadsPerFrame;
+    float uploadTimeBudgetInSec;
+    int prefetchFrames;
+    int prefetchSteps;
+    
+    vector<ofxScrollViewTileID> visibleTiles;
+    vector<ofxScrollViewTileID> neededTiles;
+    vector<ofxScrollViewTileID> prefetchTiles;
+    vector<ofxScrollViewTileRequest> requests;
+
+protected:
+    
+    void uploadLoadedTiles();
+    bool isTileNeeded(const ofxScrollViewTileID & tileID);
+    void drawTile(const ofxScrollViewTileID & tileID);
+};
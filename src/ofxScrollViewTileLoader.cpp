@@ -0,0 +1,162 @@
+//
+//  ofxScrollViewTileLoader.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTileLoader.h"
+
+//--------------------------------------------------------------
+static bool sortRequests(const ofxScrollViewTileRequest & a, const ofxScrollViewTileRequest & b) {
+    if(a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return a.tileID.level > b.tileID.level; // coarse tiles first, they cover the most screen.
+}
+
+//--------------------------------------------------------------
+ofxScrollViewTileWorker::ofxScrollViewTileWorker(ofxScrollViewTileLoader * value, int workerIndex, int numOfPixels) {
+    loader = value;
+    index = workerIndex;
+    
+    pixelsPool.resize(numOfPixels);
+    pixelsFree.setup(numOfPixels);
+    results.setup(numOfPixels);
+    for(int i=0; i<pixelsPool.size(); i++) {
+        pixelsFree.push(&pixelsPool[i]);
+    }
+}
+
+void ofxScrollViewTileWorker::threadedFunction() {
+    ofPixels * pixels = NULL;
+    
+    while(isThreadRunning() == true) {
+        
+        if(pixels == NULL) {
+            bool bFree = pixelsFree.pop(pixels);
+            if(bFree == false) {
+                sleep(1); // all pixels are waiting on the main thread to upload them.
+                continue;
+            }
+        }
+        
+        ofxScrollViewTileID tileID;
+        bool bRequest = loader->waitForRequest(tileID, 10);
+        if(bRequest == false) {
+            continue;
+        }
+        
+        ofxScrollViewTileResult result;
+        result.tileID = tileID;
+        result.pixels = pixels;
+        result.workerIndex = index;
+        result.bLoaded = loader->source->loadTile(tileID, *pixels);
+        
+        // results can hold the whole pixels pool so this never fails.
+        results.push(result);
+        pixels = NULL;
+    }
+}
+
+//--------------------------------------------------------------
+ofxScrollViewTileLoader::ofxScrollViewTileLoader() {
+    source = NULL;
+    workerIndexNext = 0;
+}
+
+ofxScrollViewTileLoader::~ofxScrollViewTileLoader() {
+    close();
+}
+
+void ofxScrollViewTileLoader::setup(ofxScrollViewTileSource * value, int numOfWorkers, int numOfPixelsPerWorker) {
+    close();
+    
+    source = value;
+    
+    numOfWorkers = MAX(numOfWorkers, 1);
+    numOfPixelsPerWorker = MAX(numOfPixelsPerWorker, 1);
+    
+    for(int i=0; i<numOfWorkers; i++) {
+        ofxScrollViewTileWorker * worker = new ofxScrollViewTileWorker(this, i, numOfPixelsPerWorker);
+        workers.push_back(worker);
+        worker->startThread();
+    }
+}
+
+void ofxScrollViewTileLoader::close() {
+    for(int i=0; i<workers.size(); i++) {
+        workers[i]->stopThread();
+    }
+    requestCondition.notify_all();
+    for(int i=0; i<workers.size(); i++) {
+        workers[i]->waitForThread();
+        delete workers[i];
+    }
+    workers.clear();
+    workerIndexNext = 0;
+    
+    std::lock_guard<std::mutex> lock(requestMutex);
+    requestsPending.clear();
+    requestsInFlight.clear();
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTileLoader::setRequests(const vector<ofxScrollViewTileRequest> & requests) {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        
+        // pending requests are replaced every frame, only tiles already being decoded carry over.
+        requestsPending.clear();
+        for(int i=0; i<requests.size(); i++) {
+            if(requestsInFlight.count(requests[i].tileID) > 0) {
+                continue;
+            }
+            requestsPending.push_back(requests[i]);
+        }
+        stable_sort(requestsPending.begin(), requestsPending.end(), sortRequests);
+    }
+    
+    requestCondition.notify_all();
+}
+
+bool ofxScrollViewTileLoader::getLoaded(ofxScrollViewTileResult & result) {
+    // round robin so one busy worker can't starve the others.
+    for(int i=0; i<workers.size(); i++) {
+        ofxScrollViewTileWorker * worker = workers[workerIndexNext];
+        workerIndexNext = (workerIndexNext + 1) % workers.size();
+        
+        bool bLoaded = worker->results.pop(result);
+        if(bLoaded == false) {
+            continue;
+        }
+        
+        std::lock_guard<std::mutex> lock(requestMutex);
+        requestsInFlight.erase(result.tileID);
+        return true;
+    }
+    return false;
+}
+
+void ofxScrollViewTileLoader::release(const ofxScrollViewTileResult & result) {
+    if(result.workerIndex < 0 || result.workerIndex >= workers.size()) {
+        return;
+    }
+    workers[result.workerIndex]->pixelsFree.push(result.pixels);
+}
+
+//--------------------------------------------------------------
+bool ofxScrollViewTileLoader::waitForRequest(ofxScrollViewTileID & tileID, int timeoutMillis) {
+    std::unique_lock<std::mutex> lock(requestMutex);
+    if(requestsPending.size() == 0) {
+        requestCondition.wait_for(lock, std::chrono::milliseconds(timeoutMillis));
+    }
+    if(requestsPending.size() == 0) {
+        return false;
+    }
+    
+    tileID = requestsPending.front().tileID;
+    requestsPending.pop_front();
+    requestsInFlight.insert(tileID);
+    
+    return true;
+}
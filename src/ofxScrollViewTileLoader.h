@@ -0,0 +1,90 @@
+//
+//  ofxScrollViewTileLoader.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxScrollViewTileSource.h"
+#include "ofxScrollViewRingBuffer.h"
+#include <mutex>
+#include <condition_variable>
+
+class ofxScrollViewTileLoader;
+
+//--------------------------------------------------------------
+class ofxScrollViewTileRequest {
+public:
+    ofxScrollViewTileRequest(const ofxScrollViewTileID & tileID=ofxScrollViewTileID(), int priority=0) {
+        this->tileID = tileID;
+        this->priority = priority;
+    }
+    ofxScrollViewTileID tileID;
+    int priority; // lower loads sooner.
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewTileResult {
+public:
+    ofxScrollViewTileResult() {
+        pixels = NULL;
+        workerIndex = -1;
+        bLoaded = false;
+    }
+    ofxScrollViewTileID tileID;
+    ofPixels * pixels;
+    int workerIndex;
+    bool bLoaded;
+};
+
+//--------------------------------------------------------------
+// decodes tiles off the main thread.
+// each worker owns a fixed pool of ofPixels which it hands to the main thread through
+// a lock free ring, the main thread hands them back through a second ring once uploaded.
+//--------------------------------------------------------------
+class ofxScrollViewTileWorker : public ofThread {
+    
+public:
+    
+    ofxScrollViewTileWorker(ofxScrollViewTileLoader * loader, int index, int numOfPixels);
+    
+    void threadedFunction();
+    
+    ofxScrollViewTileLoader * loader;
+    int index;
+    
+    vector<ofPixels> pixelsPool;
+    ofxScrollViewRingBuffer<ofPixels *> pixelsFree;  // main thread -> worker.
+    ofxScrollViewRingBuffer<ofxScrollViewTileResult> results; // worker -> main thread.
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewTileLoader {
+    
+public:
+    
+    ofxScrollViewTileLoader();
+    ~ofxScrollViewTileLoader();
+    
+    void setup(ofxScrollViewTileSource * source, int numOfWorkers=2, int numOfPixelsPerWorker=4);
+    void close();
+    
+    //---------------------------------------------------------- main thread.
+    void setRequests(const vector<ofxScrollViewTileRequest> & requests);
+    bool getLoaded(ofxScrollViewTileResult & result);
+    void release(const ofxScrollViewTileResult & result);
+    
+    //---------------------------------------------------------- worker threads.
+    bool waitForRequest(ofxScrollViewTileID & tileID, int timeoutMillis);
+    
+    ofxScrollViewTileSource * source;
+    vector<ofxScrollViewTileWorker *> workers;
+    int workerIndexNext;
+    
+    std::mutex requestMutex;
+    std::condition_variable requestCondition;
+    deque<ofxScrollViewTileRequest> requestsPending;
+    set<ofxScrollViewTileID> requestsInFlight;
+};
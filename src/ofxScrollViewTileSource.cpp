@@ -0,0 +1,150 @@
+//
+//  ofxScrollViewTileSource.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTileSource.h"
+
+//--------------------------------------------------------------
+int ofxScrollViewTileSource::getLevelWidth(int level) {
+    return (getWidth() + (1 << level) - 1) >> level;
+}
+
+int ofxScrollViewTileSource::getLevelHeight(int level) {
+    return (getHeight() + (1 << level) - 1) >> level;
+}
+
+int ofxScrollViewTileSource::getNumCols(int level) {
+    int size = getTileSize();
+    return (getLevelWidth(level) + size - 1) / size;
+}
+
+int ofxScrollViewTileSource::getNumRows(int level) {
+    int size = getTileSize();
+    return (getLevelHeight(level) + size - 1) / size;
+}
+
+bool ofxScrollViewTileSource::isTileValid(const ofxScrollViewTileID & tileID) {
+    bool bValid = true;
+    bValid = bValid && (tileID.level >= 0);
+    bValid = bValid && (tileID.level < getNumLevels());
+    bValid = bValid && (tileID.col >= 0);
+    bValid = bValid && (tileID.row >= 0);
+    bValid = bValid && (tileID.col < getNumCols(tileID.level));
+    bValid = bValid && (tileID.row < getNumRows(tileID.level));
+    return bValid;
+}
+
+ofRectangle ofxScrollViewTileSource::getTileRectInLevel(const ofxScrollViewTileID & tileID) {
+    int size = getTileSize();
+    int x = tileID.col * size;
+    int y = tileID.row * size;
+    int w = MIN(size, getLevelWidth(tileID.level) - x);
+    int h = MIN(size, getLevelHeight(tileID.level) - y);
+    return ofRectangle(x, y, w, h);
+}
+
+ofRectangle ofxScrollViewTileSource::getTileRect(const ofxScrollViewTileID & tileID) {
+    // tile rect in level 0 pixels.
+    ofRectangle rect = getTileRectInLevel(tileID);
+    float sx = getWidth() / (float)getLevelWidth(tileID.level);
+    float sy = getHeight() / (float)getLevelHeight(tileID.level);
+    rect.x *= sx;
+    rect.y *= sy;
+    rect.width *= sx;
+    rect.height *= sy;
+    return rect;
+}
+
+int ofxScrollViewTileSource::getNumLevelsForSize(int width, int height, int tileSize) {
+    int numLevels = 1;
+    while(width > tileSize || height > tileSize) {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+        numLevels += 1;
+    }
+    return numLevels;
+}
+
+//--------------------------------------------------------------
+ofxScrollViewTilePyramid::ofxScrollViewTilePyramid() {
+    tileSize = 256;
+}
+
+ofxScrollViewTilePyramid::~ofxScrollViewTilePyramid() {
+    clear();
+}
+
+bool ofxScrollViewTilePyramid::setup(const string & imagePath, int size) {
+    ofPixels pixels;
+    bool bLoaded = ofLoadImage(pixels, imagePath);
+    if(bLoaded == false) {
+        ofLogError("ofxScrollViewTilePyramid", "setup(): couldn't load image " + imagePath);
+        return false;
+    }
+    return setup(pixels, size);
+}
+
+bool ofxScrollViewTilePyramid::setup(const ofPixels & pixels, int size) {
+    clear();
+    
+    if(pixels.isAllocated() == false || size <= 0) {
+        return false;
+    }
+    
+    tileSize = size;
+    
+    int numLevels = getNumLevelsForSize(pixels.getWidth(), pixels.getHeight(), tileSize);
+    levels.resize(numLevels);
+    levels[0] = pixels;
+    
+    for(int i=1; i<numLevels; i++) {
+        const ofPixels & levelPrev = levels[i-1];
+        int w = (levelPrev.getWidth() + 1) / 2;
+        int h = (levelPrev.getHeight() + 1) / 2;
+        levels[i] = levelPrev;
+        levels[i].resize(w, h, OF_INTERPOLATE_BILINEAR);
+    }
+    
+    return true;
+}
+
+void ofxScrollViewTilePyramid::clear() {
+    levels.clear();
+}
+
+int ofxScrollViewTilePyramid::getWidth() {
+    if(levels.size() == 0) {
+        return 0;
+    }
+    return levels[0].getWidth();
+}
+
+int ofxScrollViewTilePyramid::getHeight() {
+    if(levels.size() == 0) {
+        return 0;
+    }
+    return levels[0].getHeight();
+}
+
+int ofxScrollViewTilePyramid::getTileSize() {
+    return tileSize;
+}
+
+int ofxScrollViewTilePyramid::getNumLevels() {
+    return levels.size();
+}
+
+bool ofxScrollViewTilePyramid::loadTile(const ofxScrollViewTileID & tileID, ofPixels & pixels) {
+    if(isTileValid(tileID) == false) {
+        return false;
+    }
+    ofRectangle rect = getTileRectInLevel(tileID);
+    levels[tileID.level].cropTo(pixels, rect.x, rect.y, rect.width, rect.height);
+    return true;
+}
+
+const ofPixels & ofxScrollViewTilePyramid::getLevelPixels(int level) {
+    return levels[level];
+}
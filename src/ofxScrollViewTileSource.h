@@ -0,0 +1,97 @@
+//
+//  ofxScrollViewTileSource.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+//--------------------------------------------------------------
+class ofxScrollViewTileID {
+public:
+    ofxScrollViewTileID(int level=0, int col=0, int row=0) {
+        this->level = level;
+        this->col = col;
+        this->row = row;
+    }
+    bool operator == (const ofxScrollViewTileID & other) const {
+        return (level == other.level) && (col == other.col) && (row == other.row);
+    }
+    bool operator != (const ofxScrollViewTileID & other) const {
+        return !(*this == other);
+    }
+    bool operator < (const ofxScrollViewTileID & other) const {
+        if(level != other.level) {
+            return level < other.level;
+        }
+        if(row != other.row) {
+            return row < other.row;
+        }
+        return col < other.col;
+    }
+    ofxScrollViewTileID getParent() const {
+        return ofxScrollViewTileID(level + 1, col / 2, row / 2);
+    }
+    int level;
+    int col;
+    int row;
+};
+
+//--------------------------------------------------------------
+// a tile source describes an image pyramid.
+// level 0 is full resolution, each level after is half the size of the one before,
+// and every level is cut into square tiles of getTileSize() pixels.
+// loadTile() may be called from worker threads so it must be thread safe.
+//--------------------------------------------------------------
+class ofxScrollViewTileSource {
+    
+public:
+    
+    virtual ~ofxScrollViewTileSource() {}
+    
+    virtual int getWidth() = 0;
+    virtual int getHeight() = 0;
+    virtual int getTileSize() = 0;
+    virtual int getNumLevels() = 0;
+    
+    virtual bool loadTile(const ofxScrollViewTileID & tileID, ofPixels & pixels) = 0;
+    
+    int getLevelWidth(int level);
+    int getLevelHeight(int level);
+    int getNumCols(int level);
+    int getNumRows(int level);
+    bool isTileValid(const ofxScrollViewTileID & tileID);
+    ofRectangle getTileRectInLevel(const ofxScrollViewTileID & tileID);
+    ofRectangle getTileRect(const ofxScrollViewTileID & tileID);
+    
+    static int getNumLevelsForSize(int width, int height, int tileSize);
+};
+
+//--------------------------------------------------------------
+// in memory tile source, builds all pyramid levels from a single image.
+//--------------------------------------------------------------
+class ofxScrollViewTilePyramid : public ofxScrollViewTileSource {
+    
+public:
+    
+    ofxScrollViewTilePyramid();
+    ~ofxScrollViewTilePyramid();
+    
+    bool setup(const string & imagePath, int tileSize=256);
+    bool setup(const ofPixels & pixels, int tileSize=256);
+    void clear();
+    
+    int getWidth();
+    int getHeight();
+    int getTileSize();
+    int getNumLevels();
+    
+    bool loadTile(const ofxScrollViewTileID & tileID, ofPixels & pixels);
+    
+    const ofPixels & getLevelPixels(int level);
+    
+    vector<ofPixels> levels;
+    int tileSize;
+};
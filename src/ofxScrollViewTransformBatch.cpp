@@ -0,0 +1,104 @@
+//
+//  ofxScrollViewTransformBatch.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+
+#include "ofxScrollViewTransformBatch.h"
+
+#if !defined(OFX_SCROLL_VIEW_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define OFX_SCROLL_VIEW_SSE
+    #include <emmintrin.h>
+#elif !defined(OFX_SCROLL_VIEW_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define OFX_SCROLL_VIEW_NEON
+    #include <arm_neon.h>
+#endif
+
+//--------------------------------------------------------------
+void ofxScrollViewTransformBatch::transformPoints(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfPoints) {
+    float offset[4] = {(float)transform.x, (float)transform.y, (float)transform.x, (float)transform.y};
+    transformFloats(src, dst, numOfPoints * 2, transform.scale, offset);
+}
+
+void ofxScrollViewTransformBatch::transformRects(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfRects) {
+    float offset[4] = {(float)transform.x, (float)transform.y, 0, 0};
+    transformFloats(src, dst, numOfRects * 4, transform.scale, offset);
+}
+
+void ofxScrollViewTransformBatch::transformPointsInverse(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfPoints) {
+    if(transform.scale == 0) {
+        return;
+    }
+    ofxScrollViewScalar scale = 1.0 / transform.scale;
+    float x = -transform.x * scale;
+    float y = -transform.y * scale;
+    float offset[4] = {x, y, x, y};
+    transformFloats(src, dst, numOfPoints * 2, scale, offset);
+}
+
+void ofxScrollViewTransformBatch::transformRectsInverse(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfRects) {
+    if(transform.scale == 0) {
+        return;
+    }
+    ofxScrollViewScalar scale = 1.0 / transform.scale;
+    float offset[4] = {(float)(-transform.x * scale), (float)(-transform.y * scale), 0, 0};
+    transformFloats(src, dst, numOfRects * 4, scale, offset);
+}
+
+const char * ofxScrollViewTransformBatch::getKernelName() {
+#if defined(OFX_SCROLL_VIEW_SSE)
+    return "sse";
+#elif defined(OFX_SCROLL_VIEW_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofxScrollViewTransformBatch::transformFloats(const float * src, float * dst, int numOfFloats, float scale, const float offset[4]) {
+    
+    int i = 0;
+
+#if defined(OFX_SCROLL_VIEW_SSE)
+    
+    __m128 s = _mm_set1_ps(scale);
+    __m128 o = _mm_loadu_ps(offset);
+    for(; i+16<=numOfFloats; i+=16) { // four vectors a loop to keep the pipeline full.
+        __m128 a = _mm_loadu_ps(src + i);
+        __m128 b = _mm_loadu_ps(src + i + 4);
+        __m128 c = _mm_loadu_ps(src + i + 8);
+        __m128 d = _mm_loadu_ps(src + i + 12);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(a, s), o));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_mul_ps(b, s), o));
+        _mm_storeu_ps(dst + i + 8, _mm_add_ps(_mm_mul_ps(c, s), o));
+        _mm_storeu_ps(dst + i + 12, _mm_add_ps(_mm_mul_ps(d, s), o));
+    }
+    for(; i+4<=numOfFloats; i+=4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), s), o));
+    }
+
+#elif defined(OFX_SCROLL_VIEW_NEON)
+    
+    float32x4_t s = vdupq_n_f32(scale);
+    float32x4_t o = vld1q_f32(offset);
+    for(; i+16<=numOfFloats; i+=16) {
+        float32x4_t a = vld1q_f32(src + i);
+        float32x4_t b = vld1q_f32(src + i + 4);
+        float32x4_t c = vld1q_f32(src + i + 8);
+        float32x4_t d = vld1q_f32(src + i + 12);
+        vst1q_f32(dst + i, vmlaq_f32(o, a, s));
+        vst1q_f32(dst + i + 4, vmlaq_f32(o, b, s));
+        vst1q_f32(dst + i + 8, vmlaq_f32(o, c, s));
+        vst1q_f32(dst + i + 12, vmlaq_f32(o, d, s));
+    }
+    for(; i+4<=numOfFloats; i+=4) {
+        vst1q_f32(dst + i, vmlaq_f32(o, vld1q_f32(src + i), s));
+    }
+
+#endif
+    
+    for(; i<numOfFloats; i++) { // the tail, or everything without simd.
+        dst[i] = src[i] * scale + offset[i & 3];
+    }
+}
@@ -0,0 +1,39 @@
+//
+//  ofxScrollViewTransformBatch.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  moves whole arrays of points or rects through a view transform in one call,
+//  for things like gps tracks, scatter plots and annotation anchors.
+//  points are packed x, y pairs and rects are packed x, y, width, height,
+//  so arrays of ofVec2f or plain float buffers can be passed straight in.
+//  runs four floats at a time with SSE on x86 and NEON on ARM, plain loops elsewhere
+//  or when OFX_SCROLL_VIEW_NO_SIMD is defined.
+//  nothing is clamped, unlike getScreenPointAtContentPoint(), points off the content stay off it.
+//  src and dst can be the same array.
+//
+
+#pragma once
+
+#include "ofxScrollViewTypes.h"
+
+//--------------------------------------------------------------
+class ofxScrollViewTransformBatch {
+
+public:
+    
+    // screen = content * scale + (x, y).
+    static void transformPoints(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfPoints);
+    static void transformRects(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfRects);
+    
+    // content = (screen - (x, y)) / scale.
+    static void transformPointsInverse(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfPoints);
+    static void transformRectsInverse(const ofxScrollViewTransform & transform, const float * src, float * dst, int numOfRects);
+    
+    static const char * getKernelName(); // "sse", "neon" or "scalar".
+
+protected:
+    
+    // dst[i] = src[i] * scale + offset[i % 4], the layout of both points and rects repeats every four floats.
+    static void transformFloats(const float * src, float * dst, int numOfFloats, float scale, const float offset[4]);
+};
@@ -0,0 +1,143 @@
+//
+//  ofxScrollViewTypes.h
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  point, rect, transform and input event types used by the openFrameworks free parts of ofxScrollView.
+//
+
+#pragma once
+
+#include <cmath>
+#include <stdint.h>
+
+//--------------------------------------------------------------
+// float by default. define OFX_SCROLL_VIEW_DOUBLE for content past about 10^6 pixels
+// or scales spanning more than a few orders of magnitude, where float positions start to jitter.
+//--------------------------------------------------------------
+#ifdef OFX_SCROLL_VIEW_DOUBLE
+typedef double ofxScrollViewScalar;
+#else
+typedef float ofxScrollViewScalar;
+#endif
+
+//--------------------------------------------------------------
+class ofxScrollViewVec2 {
+public:
+    ofxScrollViewVec2(ofxScrollViewScalar x=0, ofxScrollViewScalar y=0) {
+        this->x = x;
+        this->y = y;
+    }
+    void set(ofxScrollViewScalar value) {
+        x = y = value;
+    }
+    void set(ofxScrollViewScalar x, ofxScrollViewScalar y) {
+        this->x = x;
+        this->y = y;
+    }
+    ofxScrollViewScalar length() const {
+        return std::sqrt(x * x + y * y);
+    }
+    ofxScrollViewVec2 operator + (const ofxScrollViewVec2 & v) const {
+        return ofxScrollViewVec2(x + v.x, y + v.y);
+    }
+    ofxScrollViewVec2 operator - (const ofxScrollViewVec2 & v) const {
+        return ofxScrollViewVec2(x - v.x, y - v.y);
+    }
+    ofxScrollViewVec2 operator * (ofxScrollViewScalar f) const {
+        return ofxScrollViewVec2(x * f, y * f);
+    }
+    ofxScrollViewVec2 & operator += (const ofxScrollViewVec2 & v) {
+        x += v.x;
+        y += v.y;
+        return *this;
+    }
+    ofxScrollViewVec2 & operator -= (const ofxScrollViewVec2 & v) {
+        x -= v.x;
+        y -= v.y;
+        return *this;
+    }
+    ofxScrollViewVec2 & operator *= (ofxScrollViewScalar f) {
+        x *= f;
+        y *= f;
+        return *this;
+    }
+    bool operator == (const ofxScrollViewVec2 & v) const {
+        return (x == v.x) && (y == v.y);
+    }
+    bool operator != (const ofxScrollViewVec2 & v) const {
+        return !(*this == v);
+    }
+    ofxScrollViewScalar x;
+    ofxScrollViewScalar y;
+};
+
+//--------------------------------------------------------------
+class ofxScrollViewRect {
+public:
+    ofxScrollViewRect(ofxScrollViewScalar x=0, ofxScrollViewScalar y=0, ofxScrollViewScalar width=0, ofxScrollViewScalar height=0) {
+        this->x = x;
+        this->y = y;
+        this->width = width;
+        this->height = height;
+    }
+    bool isEmpty() const {
+        return (width == 0) && (height == 0);
+    }
+    bool inside(ofxScrollViewScalar px, ofxScrollViewScalar py) const {
+        return (px > x) && (py > y) && (px < x + width) && (py < y + height);
+    }
+    bool operator == (const ofxScrollViewRect & r) const {
+        return (x == r.x) && (y == r.y) && (width == r.width) && (height == r.height);
+    }
+    bool operator != (const ofxScrollViewRect & r) const {
+        return !(*this == r);
+    }
+    ofxScrollViewScalar x;
+    ofxScrollViewScalar y;
+    ofxScrollViewScalar width;
+    ofxScrollViewScalar height;
+};
+
+//--------------------------------------------------------------
+// 2D scale and translate that maps content points to screen points.
+//--------------------------------------------------------------
+class ofxScrollViewTransform {
+public:
+    ofxScrollViewTransform() {
+        scale = 1.0;
+        x = 0;
+        y = 0;
+    }
+    bool operator == (const ofxScrollViewTransform & t) const {
+        return (scale == t.scale) && (x == t.x) && (y == t.y);
+    }
+    bool operator != (const ofxScrollViewTransform & t) const {
+        return !(*this == t);
+    }
+    ofxScrollViewScalar scale;
+    ofxScrollViewScalar x;
+    ofxScrollViewScalar y;
+};
+
+//--------------------------------------------------------------
+// one touch or update() call, as recorded by ofxScrollViewInputRecorder
+// and as posted to a view from other threads.
+//--------------------------------------------------------------
+enum ofxScrollViewInputEventType {
+    OFX_SCROLL_VIEW_INPUT_UPDATE = 0,
+    OFX_SCROLL_VIEW_INPUT_TOUCH_DOWN,
+    OFX_SCROLL_VIEW_INPUT_TOUCH_MOVED,
+    OFX_SCROLL_VIEW_INPUT_TOUCH_UP,
+    OFX_SCROLL_VIEW_INPUT_TOUCH_DOUBLE_TAP,
+    OFX_SCROLL_VIEW_INPUT_TOUCH_CANCELLED
+};
+
+struct ofxScrollViewInputEvent {
+    double timeInSec;       // the view clock when the event came in, kept as is so playback gets the same times.
+    float x;
+    float y;
+    int32_t touchID;        // platform touch ids can be any int.
+    uint8_t type;           // ofxScrollViewInputEventType.
+    uint8_t reserved[3];    // 24 bytes with no padding, so files never hold stray bytes.
+};
@@ -0,0 +1,382 @@
+//
+//  main.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  tests for ofxScrollViewCore, run by ctest.
+//  runs without openFrameworks or a GL context, time is driven by a fake clock
+//  so every run steps through exactly the same frames.
+//
+//  usage:
+//  ofxScrollViewTests
+//
+//  prints each failed check and returns 1 when any failed.
+//
+
+#include "ofxScrollViewCore.h"
+#include "ofxScrollViewContentIndex.h"
+#include "ofxScrollViewList.h"
+#include "ofxScrollViewInputRecord.h"
+#include "ofxScrollViewRingBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------
+static int numOfChecks = 0;
+static int numOfFailures = 0;
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+static bool check(bool bPassed, const char * condition, const char * file, int line) {
+    numOfChecks += 1;
+    if(bPassed == false) {
+        numOfFailures += 1;
+        printf("%s:%d: check failed: %s\n", file, line, condition);
+    }
+    return bPassed;
+}
+
+//--------------------------------------------------------------
+static double fakeTimeInSec = 0.0;
+
+static double getFakeTimeInSec() {
+    return fakeTimeInSec;
+}
+
+static unsigned int randomSeed = 1;
+
+static int getRandom(int range) { // same sequence on every platform, unlike rand().
+    randomSeed = randomSeed * 1103515245 + 12345;
+    return (randomSeed >> 16) % range;
+}
+
+//--------------------------------------------------------------
+// content index, every query checked against a loop over all the items.
+//--------------------------------------------------------------
+static ofxScrollViewRect getRandomRect() {
+    return ofxScrollViewRect(getRandom(1000), getRandom(1000), 1 + getRandom(80), 1 + getRandom(80));
+}
+
+static void checkIndexAgainstItems(ofxScrollViewContentIndex & index, const std::vector<ofxScrollViewRect> & rects, const std::vector<bool> & bInserted) {
+    int numOfInserted = 0;
+    for(int i=0; i<bInserted.size(); i++) {
+        numOfInserted += bInserted[i] ? 1 : 0;
+        CHECK(index.has(i) == bInserted[i]);
+    }
+    CHECK(index.size() == numOfInserted);
+    
+    for(int i=0; i<50; i++) {
+        ofxScrollViewRect rect(getRandom(1000) - 100, getRandom(1000) - 100, getRandom(400), getRandom(400));
+        
+        std::vector<int> itemIDs;
+        index.getItemsInRect(rect, itemIDs);
+        std::sort(itemIDs.begin(), itemIDs.end());
+        
+        std::vector<int> itemIDsExpected;
+        for(int j=0; j<rects.size(); j++) {
+            if(bInserted[j] == true && ofxScrollViewContentIndex::intersects(rects[j], rect) == true) {
+                itemIDsExpected.push_back(j);
+            }
+        }
+        CHECK(itemIDs == itemIDsExpected);
+    }
+}
+
+static void testContentIndex() {
+    randomSeed = 1;
+    
+    ofxScrollViewContentIndex index;
+    index.setup(ofxScrollViewRect(0, 0, 1100, 1100), 4, 6);
+    
+    int numOfItems = 500;
+    std::vector<ofxScrollViewRect> rects(numOfItems);
+    std::vector<bool> bInserted(numOfItems, false);
+    
+    for(int i=0; i<numOfItems; i++) {
+        rects[i] = getRandomRect();
+        index.insert(i, rects[i]);
+        bInserted[i] = true;
+    }
+    checkIndexAgainstItems(index, rects, bInserted);
+    
+    for(int i=0; i<300; i++) {
+        int itemID = getRandom(numOfItems);
+        rects[itemID] = getRandomRect();
+        index.move(itemID, rects[itemID]);
+    }
+    checkIndexAgainstItems(index, rects, bInserted);
+    
+    for(int i=0; i<numOfItems; i+=3) {
+        index.remove(i);
+        bInserted[i] = false;
+    }
+    checkIndexAgainstItems(index, rects, bInserted);
+    
+    // removed slots are reused.
+    for(int i=0; i<numOfItems; i+=6) {
+        rects[i] = getRandomRect();
+        index.insert(i, rects[i]);
+        bInserted[i] = true;
+    }
+    checkIndexAgainstItems(index, rects, bInserted);
+}
+
+//--------------------------------------------------------------
+// virtualized list, scrolled to both ends and back with the cells checked against the rows on screen.
+//--------------------------------------------------------------
+class TestListDataSource : public ofxScrollViewListDataSource {
+public:
+    int numOfRows;
+    bool bVariableRowHeights;
+    int getNumOfRows() { return numOfRows; }
+    float getRowHeight(int row) { return bVariableRowHeights ? 20 + (row % 7) * 10 : 44; }
+    bool hasVariableRowHeights() { return bVariableRowHeights; }
+    float getEstimatedRowHeight() { return 50; }
+};
+
+static void checkListCells(ofxScrollViewCore & view, ofxScrollViewList & list) {
+    const std::vector<ofxScrollViewListCell *> & cells = list.getVisibleCells();
+    CHECK(cells.size() == list.getLastVisibleRow() - list.getFirstVisibleRow() + 1);
+    
+    // every row on screen has a cell, and no row has two.
+    ofxScrollViewRect visibleRect = view.getVisibleContentRect();
+    std::vector<int> rows;
+    for(int i=0; i<cells.size(); i++) {
+        rows.push_back(cells[i]->row);
+        CHECK(ofxScrollViewContentIndex::intersects(cells[i]->rect, visibleRect));
+    }
+    std::sort(rows.begin(), rows.end());
+    for(int i=0; i<rows.size(); i++) {
+        CHECK(rows[i] == list.getFirstVisibleRow() + i);
+    }
+}
+
+static void scrollList(ofxScrollViewCore & view, ofxScrollViewList & list, float scrollY) {
+    fakeTimeInSec += 1.0 / 60.0;
+    view.setScrollPositionY(scrollY, false);
+    view.update();
+    list.update();
+}
+
+static void testList(bool bVariableRowHeights) {
+    fakeTimeInSec = 0.0;
+    ofxScrollViewCore view;
+    view.setClock(getFakeTimeInSec);
+    view.setWindowRect(ofxScrollViewRect(0, 0, 800, 600));
+    
+    TestListDataSource dataSource;
+    dataSource.numOfRows = 1000;
+    dataSource.bVariableRowHeights = bVariableRowHeights;
+    ofxScrollViewList list;
+    list.setup(&view, &dataSource);
+    
+    scrollList(view, list, 0);
+    CHECK(list.getFirstVisibleRow() == 0);
+    checkListCells(view, list);
+    int numOfCells = list.getNumOfCells();
+    
+    for(int i=1; i<=100; i++) {
+        scrollList(view, list, i / 100.0);
+        checkListCells(view, list);
+    }
+    CHECK(list.getLastVisibleRow() == dataSource.numOfRows - 1);
+    
+    for(int i=99; i>=0; i--) {
+        scrollList(view, list, i / 100.0);
+        checkListCells(view, list);
+    }
+    CHECK(list.getFirstVisibleRow() == 0);
+    
+    // cells scrolled off one end were reused at the other, not created.
+    CHECK(list.getNumOfCells() <= numOfCells + 2);
+}
+
+static void testList() {
+    testList(false);
+    testList(true);
+}
+
+//--------------------------------------------------------------
+// a recorded session played back gives the same transform after every update.
+//--------------------------------------------------------------
+static void setupView(ofxScrollViewCore & view) { // content bigger than the window, so there's room to drag and fling.
+    fakeTimeInSec = 0.0;
+    view.setClock(getFakeTimeInSec);
+    view.setWindowRect(ofxScrollViewRect(0, 0, 800, 600));
+    view.setContentRect(ofxScrollViewRect(0, 0, 8000, 6000));
+    view.setup();
+    view.setScrollPosition(0.5, 0.5, false);
+    view.update();
+}
+
+static void testRecordReplay() {
+    ofxScrollViewCore view;
+    setupView(view);
+    
+    ofxScrollViewInputRecorder recorder;
+    recorder.start();
+    view.setInputRecorder(&recorder);
+    
+    std::vector<ofxScrollViewTransform> transforms;
+    for(int i=0; i<6; i++) {
+        int direction = (i % 2 == 0) ? 1 : -1;
+        view.touchDown(400, 300, 0);
+        for(int j=1; j<=20; j++) {
+            fakeTimeInSec += 1.0 / 60.0 + (j % 3) * 0.004; // uneven frames.
+            view.touchMoved(400 - j * 15 * direction, 300 - j * 10 * direction, 0);
+            view.update();
+            transforms.push_back(view.getTransform());
+        }
+        view.touchUp(400 - 300 * direction, 300 - 200 * direction, 0);
+        for(int j=0; j<60; j++) {
+            fakeTimeInSec += 1.0 / 60.0;
+            view.update();
+            transforms.push_back(view.getTransform());
+        }
+    }
+    recorder.stop();
+    view.setInputRecorder(NULL);
+    CHECK(transforms.front() != transforms.back());
+    
+    ofxScrollViewCore viewReplay;
+    setupView(viewReplay);
+    ofxScrollViewInputPlayer player;
+    player.setEvents(recorder.getEvents());
+    player.setup(&viewReplay);
+    CHECK(player.getNumOfUpdates() == transforms.size());
+    
+    int numOfMatches = 0;
+    for(int i=0; i<transforms.size(); i++) {
+        if(player.update() == false) {
+            break;
+        }
+        numOfMatches += (viewReplay.getTransform() == transforms[i]) ? 1 : 0;
+    }
+    CHECK(numOfMatches == transforms.size());
+    CHECK(player.update() == false);
+    CHECK(player.isFinished());
+}
+
+//--------------------------------------------------------------
+// input ring buffer, order kept across the wrap and between two threads.
+//--------------------------------------------------------------
+static void testRingBuffer() {
+    ofxScrollViewRingBuffer<int> ring(5);
+    CHECK(ring.capacity() == 7);
+    CHECK(ring.isEmpty());
+    
+    int item = -1;
+    CHECK(ring.pop(item) == false);
+    CHECK(ring.peek(item) == false);
+    
+    for(int i=0; i<7; i++) {
+        CHECK(ring.push(i));
+    }
+    CHECK(ring.size() == 7);
+    CHECK(ring.push(7) == false); // full.
+    
+    CHECK(ring.peek(item) && item == 0);
+    for(int i=0; i<7; i++) {
+        CHECK(ring.pop(item) && item == i);
+    }
+    CHECK(ring.isEmpty());
+    
+    // head and tail go round many times.
+    int numOfPushed = 0;
+    int numOfPopped = 0;
+    for(int i=0; i<1000; i++) {
+        int numOfPushes = 1 + i % 5;
+        for(int j=0; j<numOfPushes; j++) {
+            if(ring.push(numOfPushed) == true) {
+                numOfPushed += 1;
+            }
+        }
+        int numOfPops = 1 + (i * 7) % 5;
+        for(int j=0; j<numOfPops; j++) {
+            if(ring.pop(item) == true) {
+                CHECK(item == numOfPopped);
+                numOfPopped += 1;
+            }
+        }
+        CHECK(ring.size() == numOfPushed - numOfPopped);
+    }
+    
+    // one producer thread, one consumer.
+    ofxScrollViewRingBuffer<int> ringThreaded(64);
+    int const numOfItems = 200000;
+    std::thread producer([&ringThreaded, numOfItems]() {
+        for(int i=0; i<numOfItems; i++) {
+            while(ringThreaded.push(i) == false) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int numOfInOrder = 0;
+    for(int i=0; i<numOfItems; i++) {
+        while(ringThreaded.pop(item) == false) {
+            std::this_thread::yield();
+        }
+        numOfInOrder += (item == i) ? 1 : 0;
+    }
+    producer.join();
+    CHECK(numOfInOrder == numOfItems);
+    CHECK(ringThreaded.isEmpty());
+}
+
+//--------------------------------------------------------------
+// a fling settles at the same place and time whatever the frame rate, the physics runs on a fixed step.
+//--------------------------------------------------------------
+static void flingUntilSettled(float frameRate, ofxScrollViewTransform & transform, double & settleTimeInSec) {
+    ofxScrollViewCore view;
+    setupView(view);
+    ofxScrollViewTransform transformStart = view.getTransform();
+    view.dragVel.set(24, -18);
+    
+    settleTimeInSec = -1;
+    for(int i=1; i<=frameRate * 10; i++) {
+        fakeTimeInSec = i / (double)frameRate;
+        view.update();
+        if(view.isSettled() == true) {
+            settleTimeInSec = fakeTimeInSec;
+            break;
+        }
+    }
+    transform = view.getTransform();
+    CHECK(transform != transformStart);
+}
+
+static void testSettleAtFrameRates() {
+    ofxScrollViewTransform transform60;
+    double settleTime60 = 0;
+    flingUntilSettled(60, transform60, settleTime60);
+    CHECK(settleTime60 > 0);
+    
+    float frameRates[] = {30, 144};
+    for(int i=0; i<2; i++) {
+        ofxScrollViewTransform transform;
+        double settleTime = 0;
+        flingUntilSettled(frameRates[i], transform, settleTime);
+        CHECK(transform == transform60);
+        
+        // noticed on the first frame after the same last step, one frame of either rate apart at most.
+        double frameTime = 1.0 / std::min(frameRates[i], 60.0f);
+        CHECK(settleTime > 0);
+        CHECK(std::fabs(settleTime - settleTime60) <= frameTime + 1e-9);
+    }
+}
+
+//--------------------------------------------------------------
+int main() {
+    
+    testContentIndex();
+    testList();
+    testRecordReplay();
+    testRingBuffer();
+    testSettleAtFrameRates();
+    
+    printf("%d checks, %d failed\n", numOfChecks, numOfFailures);
+    return (numOfFailures > 0) ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+//
+//  main.cpp
+//  Created by Lukasz Karluk on 2/06/2014.
+//  http://julapy.com/
+//
+//  command line tool that cuts a large image into an ofxScrollViewTileArchive.
+//
+//  usage:
+//  tileArchiveBuilder <input image> <output archive> [tile size] [scale] [jpg|png]
+//
+//  paths are relative to bin/data unless absolute.
+//  scale resizes the image before it is cut, eg. 4 turns sample_image.jpg into a 4x larger pyramid.
+//
+
+#include "ofMain.h"
+#include "ofxScrollViewTileArchive.h"
+
+//--------------------------------------------------------------
+int main(int argc, char * argv[]) {
+    
+    if(argc < 3) {
+        cout << "usage: tileArchiveBuilder <input image> <output archive> [tile size] [scale] [jpg|png]" << endl;
+        return 1;
+    }
+    
+    string inputPath = argv[1];
+    string outputPath = argv[2];
+    int tileSize = (argc > 3) ? atoi(argv[3]) : 256;
+    float scale = (argc > 4) ? atof(argv[4]) : 1.0;
+    string formatName = (argc > 5) ? argv[5] : "jpg";
+    
+    ofImageFormat format = OF_IMAGE_FORMAT_JPEG;
+    if(formatName == "png") {
+        format = OF_IMAGE_FORMAT_PNG;
+    }
+    
+    if(tileSize <= 0 || scale <= 0) {
+        cout << "tile size and scale must be greater than zero." << endl;
+        return 1;
+    }
+    
+    //----------------------------------------------------------
+    ofPixels pixels;
+    if(ofLoadImage(pixels, inputPath) == false) {
+        cout << "couldn't load " << inputPath << endl;
+        return 1;
+    }
+    
+    if(scale != 1.0) {
+        int w = pixels.getWidth() * scale;
+        int h = pixels.getHeight() * scale;
+        pixels.resize(w, h, OF_INTERPOLATE_BICUBIC);
+    }
+    
+    cout << "building pyramid for " << pixels.getWidth() << "x" << pixels.getHeight() << " image." << endl;
+    
+    ofxScrollViewTilePyramid pyramid;
+    pyramid.setup(pixels, tileSize);
+    pixels.clear();
+    
+    //----------------------------------------------------------
+    cout << "writing " << pyramid.getNumLevels() << " levels to " << outputPath << endl;
+    
+    bool bWritten = ofxScrollViewTileArchive::write(outputPath, pyramid, format);
+    if(bWritten == false) {
+        cout << "failed writing " << outputPath << endl;
+        return 1;
+    }
+    
+    cout << "done." << endl;
+    
+    return 0;
+}